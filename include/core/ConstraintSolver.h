@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "core/SlotBitmap.h"
+
+// Propagation-based search for one student's interviews, used by the
+// Propagation solver backend. Each (company, round) is a task whose domain
+// is the set of start slots where the student and at least one panel of the
+// company are free. Constraints:
+//   - rounds of a company run in order (precedence, both directions)
+//   - the student's interviews never overlap (disjunctive)
+//   - every set of tasks competing for the same slots must fit into the
+//     slots they can cover (capacity, a pigeonhole check)
+// Search picks the task with the smallest domain weighted by past failures,
+// tries start slots earliest first, records failed decision sets as
+// nogoods, prunes any branch whose decisions include a nogood and restarts
+// with a growing failure limit.
+class ConstraintSolver {
+public:
+    // One shortlisted company: `rounds` consecutive tasks of `length` slots
+    struct TaskGroup {
+        int rounds = 0;
+        int length = 0;
+        std::vector<const SlotBitmap*> panels;
+    };
+
+    // calendar: the student's current bookings. consumeNode is called once
+    // per search node and stops the search when it returns false.
+    ConstraintSolver(const SlotBitmap& calendar, std::vector<TaskGroup> groups,
+                     std::function<bool()> consumeNode);
+
+    // Fills starts[g][r] with the start slot of round r of group g
+    bool solve(std::vector<std::vector<int>>& starts);
+
+    long long failures() const { return failureCount; }
+
+private:
+    using Domain = std::vector<uint64_t>;
+    using Decision = std::pair<int, int>; // (task, start slot)
+
+    enum class Outcome { Solved, Failed, Restart, Aborted };
+
+    struct Task {
+        int group;
+        int length;
+        int prev = -1; // previous round of the same company
+        int next = -1;
+    };
+
+    const SlotBitmap& calendar;
+    std::vector<TaskGroup> groups;
+    std::function<bool()> consumeNode;
+    std::vector<Task> tasks;
+    std::vector<Domain> initialDomains;
+    std::vector<long long> weights;        // failures caused per task
+    std::vector<Decision> decisions;
+    std::vector<std::vector<Decision>> nogoods;          // each sorted
+    std::map<Decision, std::vector<int>> nogoodIndex;    // decision -> nogoods containing it
+    long long failureCount = 0;
+    long long failureLimit = 0;
+    std::vector<int> solution;
+
+    bool buildDomains();
+    bool propagate(std::vector<Domain>& domains);
+    bool checkCapacity(const std::vector<Domain>& domains) const;
+    Outcome search(std::vector<Domain>& domains);
+    bool isNogood() const;
+    void addNogood();
+
+    static int first(const Domain& d, int from);
+    static int last(const Domain& d, int upTo);
+    static int count(const Domain& d);
+    static Domain cover(const Domain& d, int length); // slots some start in d would occupy
+    static bool clear(Domain& d, int begin, int end); // returns true if anything changed
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "core/ScheduleStore.h"
+
+// What the scheduler optimizes once a feasible schedule has been found
+enum class Objective {
+    Feasible,     // keep the first schedule that fits
+    Makespan,     // end the last interview as early as possible
+    IdleGaps,     // shorten each student's waits between interviews on a day
+    PanelBalance  // spread each company's interview minutes evenly over its panels
+};
+
+// Cost of a schedule under one objective; lower is better. secondary is the
+// sum of interview end times, so ties go to the earlier schedule.
+struct ScheduleCost {
+    long long primary = 0;
+    long long secondary = 0;
+
+    bool operator<(const ScheduleCost& other) const {
+        return primary != other.primary ? primary < other.primary : secondary < other.secondary;
+    }
+};
+
+// Measures of a schedule reported alongside it
+struct ScheduleMetrics {
+    int makespan = 0;           // end of the last interview
+    long long idleMinutes = 0;  // gaps between a student's interviews on the same day, summed
+    long long panelSpread = 0;  // busiest minus idlest panel of each company, summed
+};
+
+// Running totals behind every objective, updated one placement at a time so
+// a local search move is priced without rescanning the schedule: end times
+// for the makespan, each student's booked slots for their idle time and
+// booked minutes per panel for the balance. Call remove with a placement's
+// old value before changing it and add with the new one afterwards.
+class CostModel {
+private:
+    Objective objective;
+    std::map<int, int> endCounts;   // end time -> interviews ending then
+    long long totalEnd = 0;
+    long long idleTotal = 0;
+    long long loadSquares = 0;      // sum of squared booked minutes per panel
+    std::unordered_map<int, std::vector<TimeSlot>> studentSlots;  // by start time
+    std::unordered_map<int, long long> studentIdle;
+    std::unordered_map<uint64_t, long long> panelLoad;            // (company, panel) -> minutes
+
+    static long long idleOf(const std::vector<TimeSlot>& slots);
+    void adjust(const Placement& placement, int sign);
+
+public:
+    explicit CostModel(Objective objective) : objective(objective) {}
+
+    void add(const Placement& placement) { adjust(placement, 1); }
+    void remove(const Placement& placement) { adjust(placement, -1); }
+
+    ScheduleCost cost() const;
+    int makespan() const { return endCounts.empty() ? 0 : endCounts.rbegin()->first; }
+    long long idleMinutes() const { return idleTotal; }
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// 64-bit FNV-1a over a canonical encoding of the values added: integers as
+// 8 little-endian bytes, strings as their length followed by their bytes.
+// The result only depends on the sequence of values, not on the platform.
+class Fingerprint {
+private:
+    uint64_t hash = 14695981039346656037ull;
+
+    void addByte(uint8_t byte) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    }
+
+public:
+    void add(uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            addByte((uint8_t)(value >> (8 * i)));
+        }
+    }
+    void add(long long value) { add((uint64_t)value); }
+    void add(int value) { add((uint64_t)(int64_t)value); }
+    void add(bool value) { add((uint64_t)value); }
+    void add(const std::string& value) {
+        add((uint64_t)value.size());
+        for (char c : value) {
+            addByte((uint8_t)c);
+        }
+    }
+
+    uint64_t value() const { return hash; }
+};
@@ -4,19 +4,18 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
 #include <algorithm>
 #include <iomanip>
-
-struct TimeSlot {
-    int startTime; // minutes from start of day
-    int endTime;
-    
-    TimeSlot(int start = 0, int end = 0) : startTime(start), endTime(end) {}
-    
-    bool overlaps(const TimeSlot& other) const {
-        return !(endTime <= other.startTime || startTime >= other.endTime);
-    }
-};
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include "core/CostModel.h"
+#include "core/PanelMatrix.h"
+#include "core/ScheduleStore.h"
+#include "core/SlotBitmap.h"
+#include "core/StartTable.h"
+#include "core/SymbolTable.h"
 
 struct Company {
     std::string name;
@@ -28,56 +27,294 @@ struct Company {
         : name(n), durationPerRound(dur), numRounds(rounds), numPanels(panels) {}
 };
 
-struct Interview {
-    std::string studentId;
-    std::string companyName;
-    int round;
-    TimeSlot timeSlot;
-    int panelId;
-    
-    Interview() : round(0), panelId(0) {}
-    Interview(std::string sid, std::string comp, int r, TimeSlot ts, int pid)
-        : studentId(sid), companyName(comp), round(r), timeSlot(ts), panelId(pid) {}
-};
-
 struct Student {
     std::string rollNumber;
     std::string name;
     std::vector<std::string> shortlistedCompanies;
+    std::vector<TimeSlot> unavailable;        // e.g. exams; never scheduled over
+    std::vector<std::string> priorities;      // shortlisted companies to book first, most wanted first
 
     Student(std::string roll = "", std::string nm = "")  // <--- add name here
         : rollNumber(roll), name(nm) {}
 };
 
 
+// How the scheduler looks for the start time of each round
+enum class SearchStrategy {
+    Step,  // advance one slot at a time through the student's free gaps, testing every panel
+    Jump   // skip directly to the earliest start where the student and some panel are both free
+};
+
+// How each student's interviews are searched for
+enum class SolverBackend {
+    Backtracking,  // company by company, each round at its earliest start
+    Propagation    // constraint propagation over all of the student's rounds at once
+};
+
+// Which side of the problem generateSchedule iterates over
+enum class SchedulingMode {
+    StudentCentric,  // each student across all of their companies, one student at a time
+    CompanyCentric   // each company round by round across all of its students
+};
+
+// Order in which students are handed to the greedy scheduler
+enum class StudentOrdering {
+    FewestShortlists,  // fewest shortlisted companies first
+    MostConstrained,   // most total interview minutes first
+    CapacityRatio,     // students of the most oversubscribed companies first
+    Randomized         // seeded shuffle
+};
+
+// Outcome of a portfolio run: the winning configuration and its conflicts
+struct PortfolioResult {
+    std::vector<std::string> conflicts;
+    StudentOrdering ordering = StudentOrdering::FewestShortlists;
+    uint64_t seed = 0;
+    int makespan = 0;      // end time of the last interview
+    int members = 0;       // configurations tried
+};
+
+// Summary of the most recent generateSchedule run
+struct ScheduleStats {
+    int studentsTotal = 0;
+    int studentsPlaced = 0;         // students with every interview scheduled
+    long long nodesExplored = 0;    // round searches performed
+    bool budgetExhausted = false;   // stopped early on the deadline or node budget
+};
+
 class InterviewScheduler {
 private:
-    std::map<std::string, Company> companies;
-    std::map<std::string, Student> students;
-    std::vector<Interview> schedule;
+    using Placement = ::Placement;
+
+    // Undo record for an interview moved during local search
+    struct Move {
+        int student;
+        int index;           // position in the student's placement list
+        Placement previous;
+    };
+
+    // State of one student's backtracking search. placements[i] was booked
+    // for shortlist entry owner[i]; failedStates memoizes (shortlist index,
+    // student calendar) pairs from which the remaining companies cannot fit.
+    // Everything except placements lives in the scratch arena of the worker
+    // running the search.
+    struct StudentSearch {
+        int student;
+        bool skipSingleRound;
+        std::vector<Placement>& placements;
+        std::pmr::vector<int> owner;
+        std::pmr::set<std::pair<int, std::pmr::vector<uint64_t>>> failedStates;
+        int attempts = 0;    // company placements tried so far
+    };
+
+    // Scratch memory of one worker for one generateSchedule call. Searches
+    // bump-allocate from it and release() drops everything at once, keeping
+    // the first block so that a worker's steady state does not hit malloc.
+    struct SearchArena {
+        std::vector<std::byte> firstBlock;
+        std::pmr::monotonic_buffer_resource resource;
+
+        explicit SearchArena(size_t bytes)
+            : firstBlock(bytes), resource(firstBlock.data(), firstBlock.size()) {}
+        void release() { resource.release(); }
+    };
+
+    // Work counter of one component during a generateSchedule call. The
+    // node budget is split between components before any of them starts, so
+    // where each one stops does not depend on the thread count.
+    struct SearchBudget {
+        long long nodes = 0;
+        long long limit = 0;     // 0 = unlimited
+        bool exhausted = false;
+    };
+
+    SymbolTable studentIds;  // roll number -> dense student id
+    SymbolTable companyIds;  // company name -> dense company id
+    std::vector<Company> companies;              // indexed by company id
+    std::vector<Student> students;               // indexed by student id
+    std::vector<std::vector<int>> shortlists;    // company ids per student id, priorities first
+    std::vector<int> priorityCount;              // leading shortlist entries that are priorities
+    ScheduleStore schedule;
+    std::vector<char> studentScheduled;          // every shortlisted company placed
     TimeSlot availableSlot;
-    std::map<std::string, std::vector<std::vector<bool>>> panelAvailability;
-    std::map<std::string, std::vector<TimeSlot>> studentSchedule;
-    int timeSlotDuration = 15; // 15-minute granularity
+    std::vector<std::vector<SlotBitmap>> panelOccupancy;            // [company][panel]
+    std::vector<PanelMatrix> panelMatrix;                           // [company], panelOccupancy transposed
+    std::vector<StartTable> panelStarts;                            // [company], round starts with a free panel
+    static constexpr int startTablePanels = 8;  // companies with fewer panels scan them directly
+    std::vector<std::vector<int>> panelMinutes;                     // [company][panel], booked interview minutes
+    std::vector<std::vector<char>> panelDropped;                    // [company][panel]
+    std::vector<SlotBitmap> studentCalendar;                        // [student]
+    std::vector<TimeSlot> dayWindows;                               // working hours of each day
+    std::vector<TimeSlot> breaks;                                   // closed for everyone
+    std::vector<std::vector<TimeSlot>> companyWindows;              // [company], empty = open all day
+    std::vector<std::vector<std::vector<TimeSlot>>> panelWindows;   // [company][panel], empty = company hours
+    SlotBitmap blockedSlots;   // outside working hours or in a break; every calendar starts from it
+    int timeSlotDuration = 15; // slot length in minutes, fixed at each reset
+    int requestedSlotDuration = 0; // 0 = derive from company durations
+    SearchStrategy searchStrategy = SearchStrategy::Jump;
+    int workerThreads = 0;     // 0 = one per hardware thread
+    StudentOrdering ordering = StudentOrdering::FewestShortlists;
+    uint64_t orderingSeed = 0; // drives every randomized choice
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    long long nodeBudget = 0;  // 0 = unlimited
+    bool localSearch = false;
+    SolverBackend solverBackend = SolverBackend::Backtracking;
+    bool singleRoundMatching = true;  // match single-round companies, falling back to the greedy result
+    SchedulingMode schedulingMode = SchedulingMode::StudentCentric;
+    Objective objective = Objective::Feasible;
+    int studentAttemptLimit = 2000; // company placements tried per student before giving up
+    static constexpr int ejectionDepth = 3; // interviews displaced in turn by one repair move
+    static constexpr int matchStartsPerStudent = 8; // grid starts each student is matched against
+    static constexpr size_t searchArenaBytes = 64 * 1024; // first block of each worker's SearchArena
+    static thread_local SearchBudget* activeBudget; // component being solved on this thread
+    ScheduleStats lastRunStats;
 
     // Helper methods
     int timeToSlot(int minutes);
     int slotToTime(int slotIndex);
     int getTotalSlots();
-    bool isStudentAvailable(const std::string& studentId, const TimeSlot& slot);
-    bool isPanelAvailable(const std::string& companyName, int panelId, const TimeSlot& slot);
-    void reservePanel(const std::string& companyName, int panelId, const TimeSlot& slot);
-    void releasePanel(const std::string& companyName, int panelId, const TimeSlot& slot);
-    int findAvailablePanel(const std::string& companyName, const TimeSlot& slot);
-    bool scheduleStudentInterviews(const std::string& studentId, int companyIndex, std::vector<Interview>& currentSchedule);
+    int resolveSlotDuration() const;
+    void rebuildStudentCalendar(int studentId);
+    int priorityRank(int studentId, int companyId) const;
+    void blockOutside(SlotBitmap& bitmap, const std::vector<TimeSlot>& windows);
+    void slotRange(const TimeSlot& slot, int& firstSlot, int& endSlot);
+    bool isStudentAvailable(int studentId, const TimeSlot& slot);
+    int findStudentGap(int studentId, int fromTime, int duration);
+    void reserveStudent(int studentId, const TimeSlot& slot);
+    void releaseStudent(int studentId, const TimeSlot& slot);
+    bool isPanelAvailable(int companyId, int panelId, const TimeSlot& slot);
+    void reservePanel(int companyId, int panelId, const TimeSlot& slot);
+    void releasePanel(int companyId, int panelId, const TimeSlot& slot);
+    void indexPanels(int companyId);
+    int choosePanel(int companyId, int startSlot, int endSlot);
+    int leastBookedPanel(int companyId, int startSlot, int endSlot);
+    int findAvailablePanel(int companyId, const TimeSlot& slot);
+    void releasePlacements(const std::vector<Placement>& placements);
+    void reservePlacements(const std::vector<Placement>& placements);
+    bool consumeNode();
+    int findEarliestStart(int studentId, int companyId, int fromTime, int& panelId);
+    bool placeCompanyRounds(int studentId, int companyId, int fromTime, std::vector<Placement>& companyInterviews);
+    void blameBlockers(const StudentSearch& search, int companyIndex, std::pmr::vector<char>& culprits);
+    bool searchCompanies(StudentSearch& search, int companyIndex, std::pmr::vector<char>& culprits);
+    bool scheduleStudentInterviews(int studentId, std::vector<Placement>& currentSchedule, bool skipSingleRound = false,
+                                   std::pmr::memory_resource* scratch = std::pmr::new_delete_resource());
+    bool solveStudentWithPropagation(int studentId, std::vector<Placement>& placed, bool skipSingleRound);
+    bool scheduleStudent(int studentId, std::vector<Placement>& placed, bool skipSingleRound = false,
+                         std::pmr::memory_resource* scratch = std::pmr::new_delete_resource());
+    bool matchCompany(int companyId, const std::vector<int>& candidates, std::vector<std::vector<Placement>>& placed,
+                      std::vector<char>& matched);
+    void scheduleComponentByCompany(const std::vector<int>& component, std::vector<std::vector<Placement>>& placed,
+                                    std::vector<char>& scheduled, std::vector<char>& timedOut);
+    void matchSingleRoundCompanies(const std::vector<int>& component, std::vector<std::vector<Placement>>& placed,
+                                   std::vector<char>& scheduled, std::vector<char>& timedOut);
+    void resetOccupancy(int slotDuration = 0);
+    void indexSchedule();
+    std::vector<int> orderStudents();
+    int computeMakespan() const;
+    CostModel costModel() const;
+    std::vector<std::vector<int>> partitionComponents(const std::vector<int>& order);
+    Interview toInterview(const Placement& placement) const;
+    template <typename Pred> std::vector<Placement> unschedule(Pred pred);
+    void dropIncompleteStudent(int studentId, std::vector<std::string>& conflicts);
+
+    // Local search (LocalSearch.cpp)
+    int roundLowerBound(const std::vector<Placement>& placements, int companyId, int round) const;
+    int roundUpperBound(const std::vector<Placement>& placements, int companyId, int round) const;
+    int studentSpan(const std::vector<Placement>& placements) const;
+    void undoMoves(std::vector<std::vector<Placement>>& placed, const std::vector<Move>& undo);
+    std::vector<std::pair<int, int>> companyPlacements(const std::vector<int>& component,
+                                                       const std::vector<std::vector<Placement>>& placed, int companyId) const;
+    int ejectForRound(int studentId, int companyId, int fromTime, int untilTime, int depth, std::vector<int>& chain,
+                      const std::vector<int>& component, std::vector<std::vector<Placement>>& placed,
+                      std::vector<Move>& undo, int& panelId);
+    bool repairStudent(int studentId, const std::vector<int>& component, std::vector<std::vector<Placement>>& placed);
+    bool compactComponent(const std::vector<int>& component, std::vector<std::vector<Placement>>& placed, CostModel* model);
+    bool swapComponent(const std::vector<int>& component, std::vector<std::vector<Placement>>& placed, CostModel* model);
+    bool retimeComponent(const std::vector<int>& component, std::vector<std::vector<Placement>>& placed, CostModel& model);
+    bool pullLastInterviews(const std::vector<int>& component, std::vector<std::vector<Placement>>& placed, CostModel& model);
+    void improveComponent(const std::vector<int>& component, std::vector<std::vector<Placement>>& placed,
+                          std::vector<char>& scheduled, bool repair);
 
 public:
+    static constexpr int maxPortfolioSize = 16; // members of one portfolio run, each a full copy of the scheduler
+    static constexpr int maxWorkerThreads = 64; // threads of one generation run
+
     void initialize(const TimeSlot& slot);
+    void initialize(const std::vector<TimeSlot>& days);
+    void addBreak(const TimeSlot& slot);
+    bool setCompanyAvailability(const std::string& companyName, const std::vector<TimeSlot>& windows);
+    bool setPanelAvailability(const std::string& companyName, int panelId, const std::vector<TimeSlot>& windows);
     void addCompany(const std::string& name, int duration, int rounds, int panels);
     void addStudent(const std::string& rollNumber, const std::string& name, const std::vector<std::string>& shortlistedCompanies);
+    void addStudent(const Student& student);
+    void setSearchStrategy(SearchStrategy strategy);
+    void setWorkerThreads(int threads);
+    void setStudentOrdering(StudentOrdering order, uint64_t seed = 0);
+    void setDeadline(std::chrono::steady_clock::time_point until);
+    void setNodeBudget(long long nodes);
+    void setLocalSearch(bool enabled);
+    void setSolverBackend(SolverBackend backend);
+    void setSingleRoundMatching(bool enabled);
+    void setSchedulingMode(SchedulingMode mode);
+    void setTimeSlotDuration(int minutes);
+    void setObjective(Objective goal);
+    void setSeed(uint64_t seed);
 
     std::vector<std::string> generateSchedule();
-    std::vector<Interview> getSchedule() const;
+    PortfolioResult generatePortfolioSchedule(int size, std::chrono::milliseconds timeBudget);
+    std::vector<std::string> improveSchedule();
+    // Books the given interviews as they are instead of searching, e.g. to
+    // reload a saved session. Entries that do not fit the current inputs are
+    // skipped and reported; rounds of a company must come in order. A derived
+    // slot length also divides every booked time, so a schedule made on a
+    // finer grid than the current companies need is restored intact.
+    std::vector<std::string> restoreSchedule(const std::vector<Interview>& interviews);
+
+    // Incremental edits to an existing schedule; only the affected student or
+    // interviews are re-placed and everything else stays fixed
+    std::vector<std::string> addLateStudent(const std::string& rollNumber, const std::string& name, const std::vector<std::string>& shortlistedCompanies);
+    std::vector<std::string> addLateStudent(const Student& student);
+    std::vector<std::string> addLateShortlist(const std::string& rollNumber, const std::string& companyName);
+    std::vector<std::string> withdrawStudent(const std::string& rollNumber);
+    std::vector<std::string> withdrawCompany(const std::string& companyName);
+    std::vector<std::string> dropPanel(const std::string& companyName, int panelId);
+
+    // Non-owning; valid until the scheduler is next modified
+    ScheduleView getSchedule() const;
+    // One student's or company's interviews in start-time order, read from
+    // indexes built after each generation or edit
+    ScheduleView getStudentSchedule(const std::string& rollNumber) const;
+    ScheduleView getCompanySchedule(const std::string& companyName) const;
+    std::vector<Company> getCompanies() const;
+    std::vector<Student> getStudents() const;
+    TimeSlot getAvailableSlot() const;
+    int getTimeSlotDuration() const;
+    const std::vector<TimeSlot>& getDays() const;
+    const std::vector<TimeSlot>& getBreaks() const;
+    std::vector<TimeSlot> getCompanyAvailability(const std::string& companyName) const;
+    std::vector<TimeSlot> getPanelAvailability(const std::string& companyName, int panelId) const;
+    std::vector<int> getDroppedPanels(const std::string& companyName) const;
+    std::vector<std::string> getUnscheduledStudents() const;
+    const ScheduleStats& getLastRunStats() const;
+    uint64_t getSeed() const;
+    Objective getObjective() const;
+    SearchStrategy getSearchStrategy() const;
+    SolverBackend getSolverBackend() const;
+    SchedulingMode getSchedulingMode() const;
+    StudentOrdering getStudentOrdering() const;
+    int getRequestedTimeSlotDuration() const; // 0 = derived from company durations
+    int getWorkerThreads() const;
+    long long getNodeBudget() const;
+    bool getLocalSearch() const;
+    bool getSingleRoundMatching() const;
+    ScheduleMetrics getScheduleMetrics() const;
+    // Hash of everything that determines the result of generateSchedule: the
+    // calendar, companies, students and every option except the thread count
+    // and deadline. Runs with equal fingerprints that do not hit a deadline
+    // produce bit-identical schedules.
+    uint64_t inputFingerprint() const;
+    // Hash of the current schedule, for comparing runs
+    uint64_t scheduleHash() const;
     std::string timeToString(int minutes);
     void printStudentSchedule(const std::string& studentId);
     void printCompleteSchedule();
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+// Min-cost max-flow by successive shortest paths (Dijkstra with node
+// potentials). Edge costs must be non-negative.
+class MinCostFlow {
+private:
+    struct Edge {
+        int to;
+        int capacity;
+        long long cost;
+    };
+
+    std::vector<Edge> edges;               // edge e and its reverse e ^ 1
+    std::vector<std::vector<int>> adjacency;
+
+public:
+    explicit MinCostFlow(int nodes);
+
+    // Returns the edge index, for reading its flow after solve()
+    int addEdge(int from, int to, int capacity, long long cost);
+
+    // Pushes as much flow as possible from source to sink at minimum cost and
+    // returns the flow. consumeNode is called once per augmenting path and
+    // stops early when it returns false.
+    int solve(int source, int sink, const std::function<bool()>& consumeNode);
+
+    int flow(int edge) const { return edges[edge ^ 1].capacity; }
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "core/SlotBitmap.h"
+
+// Occupancy of every panel of one company, stored slot-major: row s has one
+// bit per panel, set when that panel is taken in slot s. An interval is
+// tested against all panels at once by OR-ing its rows. Slots outside
+// [0, slots()) count as taken for every panel, as in SlotBitmap.
+class PanelMatrix {
+private:
+    std::vector<uint64_t> cells; // numSlots rows of stride words
+    int numPanels = 0;
+    int numSlots = 0;
+    int stride = 0;
+
+    // OR of words [word, word + 2) over rows [begin, end); acc[1] stays 0 if
+    // word is the last word of a row
+    void orRows(int begin, int end, int word, uint64_t acc[2]) const;
+    uint64_t panelMask(int word) const; // bits of real panels in one word
+
+public:
+    PanelMatrix() = default;
+    // Transposes per-panel bitmaps, which must all have the same size
+    explicit PanelMatrix(const std::vector<SlotBitmap>& panels);
+
+    int panels() const { return numPanels; }
+    int slots() const { return numSlots; }
+
+    void reserve(int panel, int begin, int end);
+    void release(int panel, int begin, int end);
+
+    // Fills free with one bit per panel, set iff the panel is free in every
+    // slot of [begin, end)
+    void freePanels(int begin, int end, std::vector<uint64_t>& free) const;
+    // Lowest panel free in every slot of [begin, end), or -1
+    int firstFreePanel(int begin, int end) const;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Number of worker threads to use when the caller asked for `requested`
+// (0 means one per hardware thread), capped by the amount of work available.
+inline int resolveWorkerCount(int requested, int tasks) {
+    int threads = requested > 0 ? requested : (int)std::thread::hardware_concurrency();
+    return std::max(1, std::min(threads, tasks));
+}
+
+// Runs fn(worker, 0) .. fn(worker, count - 1) on up to `threads` workers,
+// where worker is in [0, resolveWorkerCount(threads, count)) and no two
+// tasks run on the same worker at once. Tasks are handed out dynamically in
+// index order, so callers should put the biggest tasks first.
+template <typename Fn>
+void parallelForWorkers(int count, int threads, Fn fn) {
+    threads = resolveWorkerCount(threads, count);
+    if (threads <= 1) {
+        for (int i = 0; i < count; i++) {
+            fn(0, i);
+        }
+        return;
+    }
+
+    std::atomic<int> next(0);
+    auto worker = [&](int w) {
+        for (int i = next++; i < count; i = next++) {
+            fn(w, i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+// Runs fn(0) .. fn(count - 1) on up to `threads` workers
+template <typename Fn>
+void parallelFor(int count, int threads, Fn fn) {
+    parallelForWorkers(count, threads, [&fn](int, int i) { fn(i); });
+}
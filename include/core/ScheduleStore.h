@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "core/SymbolTable.h"
+
+// Times are minutes from midnight of the first day; day d starts at
+// d * MINUTES_PER_DAY
+const int MINUTES_PER_DAY = 24 * 60;
+
+struct TimeSlot {
+    int startTime; // minutes from midnight of the first day
+    int endTime;
+    
+    TimeSlot(int start = 0, int end = 0) : startTime(start), endTime(end) {}
+    
+    bool overlaps(const TimeSlot& other) const {
+        return !(endTime <= other.startTime || startTime >= other.endTime);
+    }
+};
+
+struct Interview {
+    std::string studentId;
+    std::string companyName;
+    int round;
+    TimeSlot timeSlot;
+    int panelId;
+    
+    Interview() : round(0), panelId(0) {}
+    Interview(std::string sid, std::string comp, int r, TimeSlot ts, int pid)
+        : studentId(sid), companyName(comp), round(r), timeSlot(ts), panelId(pid) {}
+};
+
+// Interview record used while solving; names are resolved only when the
+// schedule is read.
+struct Placement {
+    int student;
+    int company;
+    int round;
+    TimeSlot timeSlot;
+    int panelId;
+};
+
+// Input iterator over anything indexable whose operator[] returns by value
+template <typename Container, typename Value>
+class IndexIterator {
+private:
+    const Container* container;
+    size_t index;
+
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Value;
+
+    IndexIterator(const Container* container, size_t index) : container(container), index(index) {}
+
+    Value operator*() const { return (*container)[index]; }
+    IndexIterator& operator++() { ++index; return *this; }
+    bool operator==(const IndexIterator& other) const { return index == other.index; }
+    bool operator!=(const IndexIterator& other) const { return index != other.index; }
+};
+
+// Rows of a schedule grouped by one key column, each group in start-time
+// order. Offsets are CSR style: group k is rows[offsets[k], offsets[k + 1]),
+// so looking up a group is O(1) and its rows are contiguous.
+class ScheduleIndex {
+private:
+    std::vector<int32_t> offsets;
+    std::vector<int32_t> rows;
+
+public:
+    // order lists every row by start time; keys outside [0, keyCount) are skipped
+    void build(const std::vector<int32_t>& keys, size_t keyCount, const std::vector<int32_t>& order);
+    void clear();
+
+    size_t keyCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    const int32_t* begin(int key) const { return rows.data() + offsets[key]; }
+    const int32_t* end(int key) const { return rows.data() + offsets[key + 1]; }
+};
+
+// Column-wise storage for the committed schedule. Ids and times take 32 bits
+// and round and panel 16, so a record is 20 bytes against roughly 90 for an
+// Interview with its two strings. Records read back as Placement values.
+class ScheduleStore {
+private:
+    std::vector<int32_t> students;
+    std::vector<int32_t> companies;
+    std::vector<int32_t> startTimes;
+    std::vector<int32_t> endTimes;
+    std::vector<int16_t> rounds;
+    std::vector<int16_t> panels;
+    ScheduleIndex byStudent;   // empty until buildIndexes, cleared by any edit
+    ScheduleIndex byCompany;
+
+public:
+    using const_iterator = IndexIterator<ScheduleStore, Placement>;
+
+    // Largest round number or panel id a record can hold; callers must keep
+    // companies within it
+    static constexpr int maxColumnValue = INT16_MAX;
+
+    size_t size() const { return students.size(); }
+    bool empty() const { return students.empty(); }
+    void clear();
+    void reserve(size_t count);
+    void push_back(const Placement& placement);
+    void append(const std::vector<Placement>& placements);
+
+    int student(size_t i) const { return students[i]; }
+    int company(size_t i) const { return companies[i]; }
+    int round(size_t i) const { return rounds[i]; }
+    int panelId(size_t i) const { return panels[i]; }
+    TimeSlot timeSlot(size_t i) const { return TimeSlot(startTimes[i], endTimes[i]); }
+    Placement operator[](size_t i) const;
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // Removes every record matching pred, keeping the others in order, and
+    // returns the removed ones
+    template <typename Pred>
+    std::vector<Placement> extract(Pred pred);
+
+    // Groups the current records by student and by company. Any later edit
+    // drops both indexes until they are built again.
+    void buildIndexes(size_t studentCount, size_t companyCount);
+    const ScheduleIndex& studentIndex() const { return byStudent; }
+    const ScheduleIndex& companyIndex() const { return byCompany; }
+};
+
+template <typename Pred>
+std::vector<Placement> ScheduleStore::extract(Pred pred) {
+    std::vector<Placement> removed;
+    size_t kept = 0;
+    for (size_t i = 0; i < size(); i++) {
+        Placement placement = (*this)[i];
+        if (pred(placement)) {
+            removed.push_back(placement);
+            continue;
+        }
+        students[kept] = students[i];
+        companies[kept] = companies[i];
+        startTimes[kept] = startTimes[i];
+        endTimes[kept] = endTimes[i];
+        rounds[kept] = rounds[i];
+        panels[kept] = panels[i];
+        kept++;
+    }
+    students.resize(kept);
+    companies.resize(kept);
+    startTimes.resize(kept);
+    endTimes.resize(kept);
+    rounds.resize(kept);
+    panels.resize(kept);
+    byStudent.clear();
+    byCompany.clear();
+    return removed;
+}
+
+// Read-only view of a schedule, or of a slice of its rows, that looks names
+// up on access. Owns nothing; valid until the scheduler it came from is
+// modified.
+class ScheduleView {
+private:
+    const ScheduleStore* store;
+    const SymbolTable* studentNames;
+    const SymbolTable* companyNames;
+    bool sliced = false;             // false = every row in store order
+    const int32_t* rows = nullptr;
+    size_t rowCount = 0;
+
+    size_t row(size_t i) const { return sliced ? (size_t)rows[i] : i; }
+
+public:
+    using const_iterator = IndexIterator<ScheduleView, Interview>;
+
+    ScheduleView(const ScheduleStore& store, const SymbolTable& studentNames, const SymbolTable& companyNames)
+        : store(&store), studentNames(&studentNames), companyNames(&companyNames) {}
+    ScheduleView(const ScheduleStore& store, const SymbolTable& studentNames, const SymbolTable& companyNames,
+                 const int32_t* first, const int32_t* last)
+        : store(&store), studentNames(&studentNames), companyNames(&companyNames),
+          sliced(true), rows(first), rowCount(last - first) {}
+
+    size_t size() const { return sliced ? rowCount : store->size(); }
+    bool empty() const { return size() == 0; }
+
+    const std::string& studentId(size_t i) const { return studentNames->name(store->student(row(i))); }
+    const std::string& companyName(size_t i) const { return companyNames->name(store->company(row(i))); }
+    int round(size_t i) const { return store->round(row(i)); }
+    TimeSlot timeSlot(size_t i) const { return store->timeSlot(row(i)); }
+    int panelId(size_t i) const { return store->panelId(row(i)); }
+
+    Interview operator[](size_t i) const {
+        return Interview(studentId(i), companyName(i), round(i), timeSlot(i), panelId(i));
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    std::vector<Interview> toVector() const { return std::vector<Interview>(begin(), end()); }
+};
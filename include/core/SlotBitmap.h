@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Packed occupancy map over a fixed number of time slots, 64 slots per word.
+// A set bit means the slot is taken. Slots outside [0, size()) are treated as
+// taken, so range queries never run past the end of the day.
+class SlotBitmap {
+private:
+    std::vector<uint64_t> words;
+    int numSlots = 0;
+
+    static uint64_t rangeMask(int from, int to);  // bits [from, to) of one word
+
+public:
+    explicit SlotBitmap(int slots = 0);
+
+    int size() const { return numSlots; }
+    int freeCount() const;
+    const std::vector<uint64_t>& data() const { return words; }
+    bool test(int slot) const;
+
+    // True if every slot in [begin, end) is free
+    bool isFree(int begin, int end) const;
+    void reserve(int begin, int end);
+    void release(int begin, int end);
+
+    // First free slot / first taken slot at or after `from`; size() if none
+    int nextFree(int from) const;
+    int nextBusy(int from) const;
+
+    // Earliest start >= from of a free run of `length` slots, or -1
+    int findFreeRun(int from, int length) const;
+
+    // Sets bit s of `starts` (same word layout as the bitmap) iff a free run
+    // of `length` slots begins at s
+    void freeRunStarts(int length, std::vector<uint64_t>& starts) const;
+};
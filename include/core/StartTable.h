@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+#include "core/SlotBitmap.h"
+
+// For one company and a fixed round length: how many panels are free for a
+// whole round starting at each slot, plus a bitmap of the slots where none
+// is, so the earliest possible start is a single bitmap scan. Counts are
+// adjusted incrementally around every change to a panel's bitmap.
+class StartTable {
+private:
+    int length = 0;
+    int numPanels = 0;
+    std::vector<int> freeCount;  // [slot]
+    SlotBitmap closed;           // set where freeCount is 0
+
+    void adjust(const SlotBitmap& panel, int begin, int end, int delta);
+
+public:
+    StartTable() = default;
+    StartTable(const std::vector<SlotBitmap>& panels, int length);
+
+    // Call uncount before and count after changing slots [begin, end) of one
+    // of the panels; only starts whose round overlaps the range are touched
+    void uncount(const SlotBitmap& panel, int begin, int end) { adjust(panel, begin, end, -1); }
+    void count(const SlotBitmap& panel, int begin, int end) { adjust(panel, begin, end, 1); }
+
+    // Panels free for a round starting at slot
+    int panelsFree(int slot) const;
+    // Earliest slot >= from where some panel is free for a round, or -1
+    int nextStart(int from) const;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Maps external string keys (roll numbers, company names) to dense integer
+// ids so the scheduler can keep its state in plain vectors.
+class SymbolTable {
+private:
+    std::unordered_map<std::string, int> ids;
+    std::vector<std::string> names;
+
+public:
+    // Returns the id for key, assigning the next free id on first sight.
+    int intern(const std::string& key) {
+        auto it = ids.find(key);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        int id = (int)names.size();
+        ids.emplace(key, id);
+        names.push_back(key);
+        return id;
+    }
+
+    // Returns the id for key, or -1 if it was never interned.
+    int find(const std::string& key) const {
+        auto it = ids.find(key);
+        return it == ids.end() ? -1 : it->second;
+    }
+
+    const std::string& name(int id) const { return names[id]; }
+    int size() const { return (int)names.size(); }
+
+    void clear() {
+        ids.clear();
+        names.clear();
+    }
+};
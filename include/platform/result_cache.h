@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Serialized responses of /api/schedule/generate keyed by a hash of everything
+// that determines them. The most recently used entries are kept in memory;
+// with a directory set, every entry is also written there as <key>.json and
+// read back on a memory miss, so results survive a restart. The directory
+// holds at most maxFiles entries; a disk hit refreshes the file's time and
+// the least recently used files are deleted first. The files are listed once
+// when the directory is set and tracked in memory from then on.
+class ResultCache
+{
+private:
+    struct Entry
+    {
+        uint64_t key;
+        std::string body;
+    };
+
+    size_t capacity_;
+    std::string directory_;
+    size_t maxFiles_ = 0;
+    std::list<Entry> entries_; // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+    std::list<uint64_t> files_; // keys on disk, most recently used first
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> fileIndex_;
+    std::mutex mutex_;
+
+    static std::string pathFor(const std::string &directory, uint64_t key);
+    void remember(uint64_t key, std::string body);
+    // Marks the key's file as most recently used and returns the keys whose
+    // files must go to get back to maxFiles
+    std::vector<uint64_t> touchFile(uint64_t key);
+
+public:
+    explicit ResultCache(size_t capacity);
+
+    // Entries kept in memory; the least recently used go first
+    void setCapacity(size_t capacity);
+
+    // Enables the disk tier, creating the directory if needed and pruning it
+    // to maxFiles entries
+    void setDirectory(const std::string &directory, size_t maxFiles);
+
+    // Fills body and returns true on a hit
+    bool get(uint64_t key, std::string &body);
+    void put(uint64_t key, const std::string &body);
+};
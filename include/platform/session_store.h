@@ -0,0 +1,34 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/InterviewScheduler.h"
+
+// A long-lived scheduler kept on the server so clients can apply edits and
+// query the current schedule without re-uploading the whole drive.
+struct SchedulerSession
+{
+    std::string name;
+    std::mutex mutex; // guards everything below
+    InterviewScheduler scheduler;
+    std::vector<std::string> conflicts; // from the last full generation
+    int revision = 0;                   // bumped on every change
+};
+
+class SessionStore
+{
+private:
+    std::map<std::string, std::shared_ptr<SchedulerSession>> sessions_;
+    mutable std::mutex mutex_;
+
+public:
+    // Returns false if a session with this name already exists
+    bool add(const std::shared_ptr<SchedulerSession> &session);
+    std::shared_ptr<SchedulerSession> get(const std::string &name) const;
+    bool remove(const std::string &name);
+    std::vector<std::shared_ptr<SchedulerSession>> list() const;
+};
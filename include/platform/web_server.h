@@ -2,10 +2,13 @@
 
 #include <httplib.h>
 #include <nlohmann/json.hpp>
+#include <functional>
 #include <memory>
 #include <thread>
 #include "core/InterviewScheduler.h"
 #include "platform/database.h"
+#include "platform/result_cache.h"
+#include "platform/session_store.h"
 
 using json = nlohmann::json;
 
@@ -15,10 +18,14 @@ private:
     httplib::Server server_;
     int port_;
     std::shared_ptr<Database> db_;
+    SessionStore sessions_;
+    ResultCache cache_;
 
 public:
     WebServer(int port);
     void setDatabase(std::shared_ptr<Database> db);
+    void setCacheCapacity(size_t entries);
+    void setCacheDirectory(const std::string &directory, size_t maxFiles);
     void setupRoutes();
     void start();
     void stop();
@@ -37,7 +44,21 @@ private:
     void handleAddCompany(const httplib::Request &req, httplib::Response &res);
     void handleGetStatistics(const httplib::Request &req, httplib::Response &res);
 
+    // Scheduler sessions
+    void handleCreateSession(const httplib::Request &req, httplib::Response &res);
+    void handleListSessions(const httplib::Request &req, httplib::Response &res);
+    void handleDeleteSession(const httplib::Request &req, httplib::Response &res);
+    void withSession(const httplib::Request &req, httplib::Response &res,
+                     const std::function<json(SchedulerSession &, const json &)> &action);
+    json sessionToJson(SchedulerSession &session);
+    json sessionDeltaToJson(SchedulerSession &session, const std::vector<std::string> &conflicts);
+    json sessionSnapshot(SchedulerSession &session);
+
     // Utility methods
+    void applySchedulerOptions(const json &requestData, InterviewScheduler &scheduler);
+    void loadScheduler(const json &requestData, InterviewScheduler &scheduler);
+    json solveSchedule(const json &requestData, InterviewScheduler &scheduler, std::vector<std::string> &conflicts);
+    json scheduleResponse(const InterviewScheduler &scheduler, const std::vector<std::string> &conflicts);
     void sendJsonResponse(httplib::Response &res, const json &data, int status = 200);
     void sendErrorResponse(httplib::Response &res, const std::string &error, int status = 400);
     json interviewToJson(const Interview &interview);
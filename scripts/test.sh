@@ -54,6 +54,137 @@ else
     echo "❌ Schedule generation failed"
 fi
 
+# Test 4: Late shortlist of an already shortlisted company
+echo "Test 4: Testing duplicate late shortlist..."
+curl -s -X POST http://localhost:8081/api/sessions \
+  -H "Content-Type: application/json" \
+  -d '{
+    "name": "dup-shortlist",
+    "companies": [
+      {"name": "TestCorp", "durationPerRound": 30, "numRounds": 2, "numPanels": 1}
+    ],
+    "students": [
+      {"id": "TEST001", "shortlistedCompanies": ["TestCorp"]}
+    ]
+  }' > /dev/null
+curl -s -X POST http://localhost:8081/api/sessions/dup-shortlist/shortlists \
+  -H "Content-Type: application/json" \
+  -d '{"studentId": "TEST001", "companyName": "TestCorp"}' > /dev/null
+INTERVIEWS=$(curl -s -X POST http://localhost:8081/api/sessions/dup-shortlist/regenerate \
+  -H "Content-Type: application/json" -d '{}' | grep -o '"totalInterviews": *[0-9]*' | tr -d ' ')
+
+if [ "$INTERVIEWS" = '"totalInterviews":2' ]; then
+    echo "✅ Duplicate shortlist is not booked twice"
+else
+    echo "❌ Duplicate shortlist booked twice ($INTERVIEWS)"
+fi
+
+# Test 5: Single-round companies are matched by default, booking every student on a free panel
+echo "Test 5: Testing single-round matching..."
+MATCHED=$(curl -s -X POST http://localhost:8081/api/schedule/generate \
+  -H "Content-Type: application/json" \
+  -d '{
+    "timeSlot": {"startTime": 540, "endTime": 660},
+    "companies": [
+      {"name": "OneRound", "durationPerRound": 30, "numRounds": 1, "numPanels": 1}
+    ],
+    "students": [
+      {"id": "M001", "shortlistedCompanies": ["OneRound"]},
+      {"id": "M002", "shortlistedCompanies": ["OneRound"]},
+      {"id": "M003", "shortlistedCompanies": ["OneRound"]},
+      {"id": "M004", "shortlistedCompanies": ["OneRound"], "unavailable": [{"startTime": 570, "endTime": 660}]}
+    ]
+  }' | tr -d ' \n')
+STARTS=$(echo "$MATCHED" | grep -o '"startTime":[0-9]*' | sort -u | wc -l)
+
+if echo "$MATCHED" | grep -q '"totalConflicts":0' && echo "$MATCHED" | grep -q '"totalInterviews":4' && [ "$STARTS" -eq 4 ]; then
+    echo "✅ Single-round matching places every student without overlaps"
+else
+    echo "❌ Single-round matching failed ($MATCHED)"
+fi
+
+# Test 6: Late student after a portfolio run with a derived slot length
+echo "Test 6: Testing late student after a portfolio run..."
+curl -s -X POST http://localhost:8081/api/sessions \
+  -H "Content-Type: application/json" \
+  -d '{
+    "name": "portfolio-late",
+    "timeSlot": {"startTime": 540, "endTime": 1020},
+    "portfolioSize": 3,
+    "companies": [
+      {"name": "HourCorp", "durationPerRound": 60, "numRounds": 2, "numPanels": 1}
+    ],
+    "students": [
+      {"id": "P001", "shortlistedCompanies": ["HourCorp"]},
+      {"id": "P002", "shortlistedCompanies": ["HourCorp"]},
+      {"id": "P003", "shortlistedCompanies": ["HourCorp"]}
+    ]
+  }' > /dev/null
+LATE=$(curl -s -X POST http://localhost:8081/api/sessions/portfolio-late/students \
+  -H "Content-Type: application/json" \
+  -d '{"id": "P004", "shortlistedCompanies": ["HourCorp"]}' | tr -d ' \n')
+
+if echo "$LATE" | grep -q '"conflicts":\[\]' && echo "$LATE" | grep -q '"totalInterviews":8'; then
+    echo "✅ Late student fits after a portfolio run"
+else
+    echo "❌ Late student rejected after a portfolio run ($LATE)"
+fi
+
+# Test 7: Snapshot taken after a company is withdrawn restores every interview
+echo "Test 7: Testing snapshot round-trip after a withdrawn company..."
+curl -s -X POST http://localhost:8081/api/sessions \
+  -H "Content-Type: application/json" \
+  -d '{
+    "name": "snapshot-withdraw",
+    "timeSlot": {"startTime": 540, "endTime": 1020},
+    "singleRoundMatching": false,
+    "companies": [
+      {"name": "ShortCorp", "durationPerRound": 15, "numRounds": 1, "numPanels": 1},
+      {"name": "LongCorp", "durationPerRound": 40, "numRounds": 1, "numPanels": 1}
+    ],
+    "students": [
+      {"id": "W001", "shortlistedCompanies": ["ShortCorp", "LongCorp"]},
+      {"id": "W002", "shortlistedCompanies": ["ShortCorp", "LongCorp"]}
+    ]
+  }' > /dev/null
+curl -s -X DELETE http://localhost:8081/api/sessions/snapshot-withdraw/companies/ShortCorp > /dev/null
+RESTORED=$(curl -s http://localhost:8081/api/sessions/snapshot-withdraw/snapshot \
+  | sed 's/"name": *"snapshot-withdraw"/"name": "snapshot-restored"/' \
+  | curl -s -X POST http://localhost:8081/api/sessions -H "Content-Type: application/json" -d @- | tr -d ' \n')
+
+if echo "$RESTORED" | grep -q '"conflicts":\[\]' && echo "$RESTORED" | grep -q '"totalInterviews":2'; then
+    echo "✅ Snapshot restores every interview after a withdrawn company"
+else
+    echo "❌ Snapshot lost interviews after a withdrawn company ($RESTORED)"
+fi
+
+# Test 8: A late shortlist that does not fit rolls back the student's other interviews
+echo "Test 8: Testing rollback of a late shortlist that does not fit..."
+curl -s -X POST http://localhost:8081/api/sessions \
+  -H "Content-Type: application/json" \
+  -d '{
+    "name": "late-rollback",
+    "timeSlot": {"startTime": 540, "endTime": 600},
+    "companies": [
+      {"name": "OpenCorp", "durationPerRound": 30, "numRounds": 1, "numPanels": 1},
+      {"name": "FullCorp", "durationPerRound": 30, "numRounds": 1, "numPanels": 1}
+    ],
+    "students": [
+      {"id": "L001", "shortlistedCompanies": ["OpenCorp"]},
+      {"id": "L002", "shortlistedCompanies": ["FullCorp"]},
+      {"id": "L003", "shortlistedCompanies": ["FullCorp"]}
+    ]
+  }' > /dev/null
+ROLLBACK=$(curl -s -X POST http://localhost:8081/api/sessions/late-rollback/shortlists \
+  -H "Content-Type: application/json" \
+  -d '{"studentId": "L001", "companyName": "FullCorp"}' | tr -d ' \n')
+
+if echo "$ROLLBACK" | grep -q '"totalInterviews":2' && echo "$ROLLBACK" | grep -q '"unscheduledStudents":\["L001"\]'; then
+    echo "✅ Late shortlist that does not fit keeps no partial bookings"
+else
+    echo "❌ Late shortlist left partial bookings ($ROLLBACK)"
+fi
+
 # Cleanup
 kill $SERVER_PID 2>/dev/null
 wait $SERVER_PID 2>/dev/null
@@ -0,0 +1,314 @@
+#include "core/ConstraintSolver.h"
+
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+ConstraintSolver::ConstraintSolver(const SlotBitmap& calendar, vector<TaskGroup> groups,
+                                   function<bool()> consumeNode)
+    : calendar(calendar), groups(move(groups)), consumeNode(move(consumeNode)) {
+    for (int g = 0; g < (int)this->groups.size(); g++) {
+        for (int r = 0; r < this->groups[g].rounds; r++) {
+            Task task;
+            task.group = g;
+            task.length = this->groups[g].length;
+            if (r > 0) {
+                task.prev = (int)tasks.size() - 1;
+                tasks.back().next = (int)tasks.size();
+            }
+            tasks.push_back(task);
+        }
+    }
+    weights.assign(tasks.size(), 0);
+}
+
+int ConstraintSolver::first(const Domain& d, int from) {
+    if (from < 0) from = 0;
+    int w = from >> 6;
+    if (w >= (int)d.size()) {
+        return -1;
+    }
+    uint64_t bits = d[w] & (~uint64_t(0) << (from & 63));
+    while (!bits) {
+        if (++w >= (int)d.size()) {
+            return -1;
+        }
+        bits = d[w];
+    }
+    return (w << 6) + __builtin_ctzll(bits);
+}
+
+int ConstraintSolver::last(const Domain& d, int upTo) {
+    if (upTo < 0) {
+        return -1;
+    }
+    int w = min(upTo >> 6, (int)d.size() - 1);
+    uint64_t bits = d[w];
+    if (w == (upTo >> 6) && (upTo & 63) != 63) {
+        bits &= (uint64_t(1) << ((upTo & 63) + 1)) - 1;
+    }
+    while (!bits) {
+        if (--w < 0) {
+            return -1;
+        }
+        bits = d[w];
+    }
+    return (w << 6) + 63 - __builtin_clzll(bits);
+}
+
+int ConstraintSolver::count(const Domain& d) {
+    int total = 0;
+    for (uint64_t word : d) {
+        total += __builtin_popcountll(word);
+    }
+    return total;
+}
+
+ConstraintSolver::Domain ConstraintSolver::cover(const Domain& d, int length) {
+    Domain covered = d;
+    for (int shift = 1; shift < length; shift++) {
+        int words = shift >> 6;
+        int bits = shift & 63;
+        for (int w = (int)d.size() - 1; w >= words; w--) {
+            uint64_t word = d[w - words] << bits;
+            if (bits && w - words > 0) {
+                word |= d[w - words - 1] >> (64 - bits);
+            }
+            covered[w] |= word;
+        }
+    }
+    return covered;
+}
+
+bool ConstraintSolver::clear(Domain& d, int begin, int end) {
+    begin = max(begin, 0);
+    end = min(end, (int)d.size() * 64);
+    bool changed = false;
+    for (int slot = begin; slot < end; ) {
+        int w = slot >> 6;
+        int to = min(end - (w << 6), 64);
+        uint64_t upper = (to >= 64) ? ~uint64_t(0) : ((uint64_t(1) << to) - 1);
+        uint64_t mask = upper & (~uint64_t(0) << (slot & 63));
+        changed |= (d[w] & mask) != 0;
+        d[w] &= ~mask;
+        slot = (w + 1) << 6;
+    }
+    return changed;
+}
+
+// Start slots where the student and at least one panel are free
+bool ConstraintSolver::buildDomains() {
+    vector<Domain> groupDomains(groups.size());
+    Domain panelStarts;
+    for (int g = 0; g < (int)groups.size(); g++) {
+        Domain& domain = groupDomains[g];
+        calendar.freeRunStarts(groups[g].length, domain);
+        Domain anyPanel(domain.size(), 0);
+        for (const SlotBitmap* panel : groups[g].panels) {
+            panel->freeRunStarts(groups[g].length, panelStarts);
+            for (size_t w = 0; w < anyPanel.size(); w++) {
+                anyPanel[w] |= panelStarts[w];
+            }
+        }
+        for (size_t w = 0; w < domain.size(); w++) {
+            domain[w] &= anyPanel[w];
+        }
+    }
+
+    initialDomains.clear();
+    for (const Task& task : tasks) {
+        initialDomains.push_back(groupDomains[task.group]);
+        if (first(initialDomains.back(), 0) == -1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ConstraintSolver::propagate(vector<Domain>& domains) {
+    const int numSlots = calendar.size();
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+        for (int t = 0; t < (int)tasks.size(); t++) {
+            const Task& task = tasks[t];
+            int est = first(domains[t], 0);
+            if (est == -1) {
+                return false;
+            }
+            int lst = last(domains[t], INT_MAX);
+
+            // Round precedence: next round starts after this one can end,
+            // previous round must end before this one can start
+            if (task.next != -1) {
+                changed |= clear(domains[task.next], 0, est + task.length);
+            }
+            if (task.prev != -1) {
+                changed |= clear(domains[task.prev], lst - tasks[task.prev].length + 1, numSlots);
+            }
+
+            // A fixed task blocks the overlapping starts of every other task
+            if (est == lst) {
+                for (int other = 0; other < (int)tasks.size(); other++) {
+                    if (other == t) continue;
+                    changed |= clear(domains[other], est - tasks[other].length + 1, est + task.length);
+                }
+            }
+        }
+    }
+
+    return checkCapacity(domains);
+}
+
+// Pigeonhole check: the student's interviews never overlap, so the tasks
+// whose possible slots all lie within one task's coverage must fit into
+// that many slots, and so must all tasks together. Catches sets of
+// companies competing for the same few panel slots before any search.
+bool ConstraintSolver::checkCapacity(const vector<Domain>& domains) const {
+    vector<Domain> covered;
+    covered.reserve(tasks.size());
+    Domain all(domains.empty() ? 0 : domains[0].size(), 0);
+    int totalDemand = 0;
+    for (int t = 0; t < (int)tasks.size(); t++) {
+        covered.push_back(cover(domains[t], tasks[t].length));
+        for (size_t w = 0; w < all.size(); w++) {
+            all[w] |= covered[t][w];
+        }
+        totalDemand += tasks[t].length;
+    }
+    if (totalDemand > count(all)) {
+        return false;
+    }
+
+    for (int t = 0; t < (int)tasks.size(); t++) {
+        int demand = 0;
+        for (int other = 0; other < (int)tasks.size(); other++) {
+            bool inside = true;
+            for (size_t w = 0; w < all.size() && inside; w++) {
+                inside = (covered[other][w] & ~covered[t][w]) == 0;
+            }
+            if (inside) {
+                demand += tasks[other].length;
+            }
+        }
+        if (demand > count(covered[t])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True if some nogood is a subset of the current decisions. Every earlier
+// prefix was already checked, so only nogoods containing the newest
+// decision can newly match.
+bool ConstraintSolver::isNogood() const {
+    auto it = nogoodIndex.find(decisions.back());
+    if (it == nogoodIndex.end()) {
+        return false;
+    }
+    vector<Decision> key = decisions;
+    sort(key.begin(), key.end());
+    for (int id : it->second) {
+        if (includes(key.begin(), key.end(), nogoods[id].begin(), nogoods[id].end())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ConstraintSolver::addNogood() {
+    vector<Decision> key = decisions;
+    sort(key.begin(), key.end());
+    int id = (int)nogoods.size();
+    for (const Decision& decision : key) {
+        nogoodIndex[decision].push_back(id);
+    }
+    nogoods.push_back(move(key));
+}
+
+ConstraintSolver::Outcome ConstraintSolver::search(vector<Domain>& domains) {
+    if (!consumeNode()) {
+        return Outcome::Aborted;
+    }
+    if (!propagate(domains)) {
+        return Outcome::Failed;
+    }
+
+    // Smallest domain first, scaled down by how often the task has failed
+    int chosen = -1;
+    double best = 0.0;
+    for (int t = 0; t < (int)tasks.size(); t++) {
+        int size = count(domains[t]);
+        if (size <= 1) continue;
+        double score = (double)size / (1.0 + weights[t]);
+        if (chosen == -1 || score < best) {
+            chosen = t;
+            best = score;
+        }
+    }
+    if (chosen == -1) {
+        solution.resize(tasks.size());
+        for (int t = 0; t < (int)tasks.size(); t++) {
+            solution[t] = first(domains[t], 0);
+        }
+        return Outcome::Solved;
+    }
+
+    for (int value = first(domains[chosen], 0); value != -1; value = first(domains[chosen], value + 1)) {
+        decisions.push_back({chosen, value});
+        if (!isNogood()) {
+            vector<Domain> child = domains;
+            fill(child[chosen].begin(), child[chosen].end(), 0);
+            child[chosen][value >> 6] |= uint64_t(1) << (value & 63);
+
+            Outcome outcome = search(child);
+            if (outcome != Outcome::Failed) {
+                decisions.pop_back();
+                return outcome;
+            }
+        }
+        decisions.pop_back();
+        if (++failureCount > failureLimit) {
+            return Outcome::Restart;
+        }
+    }
+
+    // No value of the chosen task works under the current decisions
+    weights[chosen]++;
+    if (!decisions.empty()) {
+        addNogood();
+    }
+    return Outcome::Failed;
+}
+
+bool ConstraintSolver::solve(vector<vector<int>>& starts) {
+    starts.assign(groups.size(), vector<int>());
+    if (tasks.empty()) {
+        return true;
+    }
+    if (!buildDomains()) {
+        return false;
+    }
+
+    // Restart with a doubling failure limit; nogoods and weights carry over
+    long long limit = 32;
+    while (true) {
+        failureLimit = failureCount + limit;
+        decisions.clear();
+        vector<Domain> domains = initialDomains;
+        Outcome outcome = search(domains);
+
+        if (outcome == Outcome::Solved) {
+            for (int t = 0; t < (int)tasks.size(); t++) {
+                starts[tasks[t].group].push_back(solution[t]);
+            }
+            return true;
+        }
+        if (outcome != Outcome::Restart) {
+            return false;
+        }
+        limit *= 2;
+    }
+}
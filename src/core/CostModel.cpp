@@ -0,0 +1,74 @@
+#include "core/CostModel.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+// Waiting time between consecutive interviews on the same day; the nights
+// between days of a multi-day drive are not idle time
+long long CostModel::idleOf(const vector<TimeSlot>& slots) {
+    long long idle = 0;
+    for (size_t i = 1; i < slots.size(); i++) {
+        if (slots[i].startTime / MINUTES_PER_DAY == slots[i - 1].endTime / MINUTES_PER_DAY) {
+            idle += max(0, slots[i].startTime - slots[i - 1].endTime);
+        }
+    }
+    return idle;
+}
+
+void CostModel::adjust(const Placement& placement, int sign) {
+    const TimeSlot& slot = placement.timeSlot;
+
+    // A student has a handful of interviews, so their idle time is simply
+    // recomputed from the sorted slots
+    vector<TimeSlot>& slots = studentSlots[placement.student];
+    auto byStart = [](const TimeSlot& a, const TimeSlot& b) { return a.startTime < b.startTime; };
+    auto at = lower_bound(slots.begin(), slots.end(), slot, byStart);
+    if (sign > 0) {
+        endCounts[slot.endTime]++;
+        slots.insert(at, slot);
+    } else {
+        // Removing a placement that was never added would corrupt every total
+        while (at != slots.end() && at->startTime == slot.startTime && at->endTime != slot.endTime) ++at;
+        auto it = endCounts.find(slot.endTime);
+        bool recorded = at != slots.end() && at->startTime == slot.startTime && it != endCounts.end();
+        assert(recorded);
+        if (!recorded) {
+            return;
+        }
+        if (--it->second == 0) {
+            endCounts.erase(it);
+        }
+        slots.erase(at);
+    }
+    totalEnd += sign * (long long)slot.endTime;
+    long long& idle = studentIdle[placement.student];
+    idleTotal -= idle;
+    idle = idleOf(slots);
+    idleTotal += idle;
+
+    long long& load = panelLoad[((uint64_t)(uint32_t)placement.company << 32) | (uint32_t)placement.panelId];
+    loadSquares -= load * load;
+    load += sign * (long long)(slot.endTime - slot.startTime);
+    loadSquares += load * load;
+}
+
+ScheduleCost CostModel::cost() const {
+    ScheduleCost result;
+    result.secondary = totalEnd;
+    switch (objective) {
+    case Objective::Makespan:
+        result.primary = makespan();
+        break;
+    case Objective::IdleGaps:
+        result.primary = idleTotal;
+        break;
+    case Objective::PanelBalance:
+        result.primary = loadSquares;
+        break;
+    case Objective::Feasible:
+        break;
+    }
+    return result;
+}
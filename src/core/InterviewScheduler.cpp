@@ -1,7 +1,18 @@
 #include "core/InterviewScheduler.h"
+#include "core/ConstraintSolver.h"
+#include "core/Fingerprint.h"
+#include "core/MinCostFlow.h"
+#include "core/Parallel.h"
+
+#include <climits>
+#include <memory>
+#include <numeric>
+#include <tuple>
 
 using namespace std;
 
+thread_local InterviewScheduler::SearchBudget* InterviewScheduler::activeBudget = nullptr;
+
 int InterviewScheduler::timeToSlot(int minutes) {
     return (minutes - availableSlot.startTime) / timeSlotDuration;
 }
@@ -14,178 +25,1749 @@ int InterviewScheduler::getTotalSlots() {
     return (availableSlot.endTime - availableSlot.startTime) / timeSlotDuration;
 }
 
-bool InterviewScheduler::isStudentAvailable(const string& studentId, const TimeSlot& slot) {
-    for (const auto& existingSlot : studentSchedule[studentId]) {
-        if (slot.overlaps(existingSlot)) {
-            return false;
+// Largest slot length that divides every round duration and the window, so no
+// interview ends partway into a slot; 15 minutes until companies are known
+int InterviewScheduler::resolveSlotDuration() const {
+    if (requestedSlotDuration > 0) {
+        return requestedSlotDuration;
+    }
+    int granularity = 0;
+    for (const auto& company : companies) {
+        if (company.numRounds > 0 && company.durationPerRound > 0) {
+            granularity = gcd(granularity, company.durationPerRound);
         }
     }
-    return true;
+    if (granularity == 0) {
+        granularity = 15;
+    }
+    auto addBounds = [&](const vector<TimeSlot>& windows) {
+        for (const auto& window : windows) {
+            granularity = gcd(granularity, window.startTime - availableSlot.startTime);
+            granularity = gcd(granularity, window.endTime - availableSlot.startTime);
+        }
+    };
+    addBounds(dayWindows);
+    addBounds(breaks);
+    for (int companyId = 0; companyId < (int)companies.size(); companyId++) {
+        addBounds(companyWindows[companyId]);
+        for (const auto& windows : panelWindows[companyId]) {
+            addBounds(windows);
+        }
+    }
+    return max(1, granularity);
 }
 
-bool InterviewScheduler::isPanelAvailable(const string& companyName, int panelId, const TimeSlot& slot) {
-    int startSlot = timeToSlot(slot.startTime);
-    int endSlot = timeToSlot(slot.endTime);
-    
-    for (int i = startSlot; i < endSlot; i++) {
-        if (i >= (int)panelAvailability[companyName][panelId].size() || 
-            panelAvailability[companyName][panelId][i]) {
-            return false;
+// Blocks every slot of the bitmap not wholly inside one of the windows
+void InterviewScheduler::blockOutside(SlotBitmap& bitmap, const vector<TimeSlot>& windows) {
+    SlotBitmap outside(bitmap.size());
+    outside.reserve(0, outside.size());
+    for (const auto& window : windows) {
+        int firstSlot = (window.startTime - availableSlot.startTime + timeSlotDuration - 1) / timeSlotDuration;
+        outside.release(firstSlot, timeToSlot(window.endTime));
+    }
+    for (int slot = outside.nextBusy(0); slot < outside.size(); ) {
+        int end = outside.nextFree(slot);
+        bitmap.reserve(slot, end);
+        slot = outside.nextBusy(end);
+    }
+}
+
+// Slots touched by an interval; a partially covered trailing slot counts as used
+void InterviewScheduler::slotRange(const TimeSlot& slot, int& firstSlot, int& endSlot) {
+    firstSlot = timeToSlot(slot.startTime);
+    endSlot = (slot.endTime - availableSlot.startTime + timeSlotDuration - 1) / timeSlotDuration;
+}
+
+bool InterviewScheduler::isStudentAvailable(int studentId, const TimeSlot& slot) {
+    int startSlot, endSlot;
+    slotRange(slot, startSlot, endSlot);
+    return studentCalendar[studentId].isFree(startSlot, endSlot);
+}
+
+// Earliest start time >= fromTime at which the student is free for `duration`
+// minutes, or -1 if no such gap remains in the window
+int InterviewScheduler::findStudentGap(int studentId, int fromTime, int duration) {
+    int firstSlot = (fromTime - availableSlot.startTime + timeSlotDuration - 1) / timeSlotDuration;
+    int length = (duration + timeSlotDuration - 1) / timeSlotDuration;
+    int slot = studentCalendar[studentId].findFreeRun(firstSlot, length);
+    return slot == -1 ? -1 : slotToTime(slot);
+}
+
+void InterviewScheduler::reserveStudent(int studentId, const TimeSlot& slot) {
+    int startSlot, endSlot;
+    slotRange(slot, startSlot, endSlot);
+    studentCalendar[studentId].reserve(startSlot, endSlot);
+}
+
+void InterviewScheduler::releaseStudent(int studentId, const TimeSlot& slot) {
+    int startSlot, endSlot;
+    slotRange(slot, startSlot, endSlot);
+    studentCalendar[studentId].release(startSlot, endSlot);
+}
+
+bool InterviewScheduler::isPanelAvailable(int companyId, int panelId, const TimeSlot& slot) {
+    int startSlot, endSlot;
+    slotRange(slot, startSlot, endSlot);
+    return panelOccupancy[companyId][panelId].isFree(startSlot, endSlot);
+}
+
+void InterviewScheduler::reservePanel(int companyId, int panelId, const TimeSlot& slot) {
+    int startSlot, endSlot;
+    slotRange(slot, startSlot, endSlot);
+    SlotBitmap& panel = panelOccupancy[companyId][panelId];
+    // Reserving only removes starts, all of which overlap the range
+    panelStarts[companyId].uncount(panel, startSlot, endSlot);
+    panel.reserve(startSlot, endSlot);
+    panelMatrix[companyId].reserve(panelId, startSlot, endSlot);
+    panelMinutes[companyId][panelId] += slot.endTime - slot.startTime;
+}
+
+void InterviewScheduler::releasePanel(int companyId, int panelId, const TimeSlot& slot) {
+    int startSlot, endSlot;
+    slotRange(slot, startSlot, endSlot);
+    SlotBitmap& panel = panelOccupancy[companyId][panelId];
+    panelStarts[companyId].uncount(panel, startSlot, endSlot);
+    panel.release(startSlot, endSlot);
+    panelStarts[companyId].count(panel, startSlot, endSlot);
+    panelMatrix[companyId].release(panelId, startSlot, endSlot);
+    panelMinutes[companyId][panelId] -= slot.endTime - slot.startTime;
+}
+
+// Rebuilds the derived panel tables of a company from its bitmaps. Keeping
+// the start table current costs more than it saves below startTablePanels,
+// so smaller companies get an empty one, which ignores updates.
+void InterviewScheduler::indexPanels(int companyId) {
+    const vector<SlotBitmap>& panels = panelOccupancy[companyId];
+    int length = (companies[companyId].durationPerRound + timeSlotDuration - 1) / timeSlotDuration;
+    panelMatrix[companyId] = PanelMatrix(panels);
+    panelStarts[companyId] = (int)panels.size() >= startTablePanels ? StartTable(panels, length) : StartTable();
+}
+
+// Panel free for slots [startSlot, endSlot), or -1; all panels are tested at
+// once and the lowest one is taken. Construction always uses this; only the
+// local search balances panels (leastBookedPanel).
+int InterviewScheduler::choosePanel(int companyId, int startSlot, int endSlot) {
+    return panelMatrix[companyId].firstFreePanel(startSlot, endSlot);
+}
+
+// Free panel for slots [startSlot, endSlot) with the fewest booked minutes, or -1
+int InterviewScheduler::leastBookedPanel(int companyId, int startSlot, int endSlot) {
+    vector<uint64_t> free;
+    panelMatrix[companyId].freePanels(startSlot, endSlot, free);
+    const vector<int>& minutes = panelMinutes[companyId];
+    int best = -1;
+    for (int w = 0; w < (int)free.size(); w++) {
+        for (uint64_t bits = free[w]; bits; bits &= bits - 1) {
+            int panelId = (w << 6) + __builtin_ctzll(bits);
+            if (best == -1 || minutes[panelId] < minutes[best]) {
+                best = panelId;
+            }
         }
     }
-    return true;
+    return best;
 }
 
-void InterviewScheduler::reservePanel(const string& companyName, int panelId, const TimeSlot& slot) {
-    int startSlot = timeToSlot(slot.startTime);
-    int endSlot = timeToSlot(slot.endTime);
-    
-    for (int i = startSlot; i < endSlot; i++) {
-        panelAvailability[companyName][panelId][i] = true;
+int InterviewScheduler::findAvailablePanel(int companyId, const TimeSlot& slot) {
+    int startSlot, endSlot;
+    slotRange(slot, startSlot, endSlot);
+    return choosePanel(companyId, startSlot, endSlot);
+}
+
+void InterviewScheduler::releasePlacements(const vector<Placement>& placements) {
+    for (const auto& i : placements) {
+        releasePanel(i.company, i.panelId, i.timeSlot);
+        releaseStudent(i.student, i.timeSlot);
     }
 }
 
-void InterviewScheduler::releasePanel(const string& companyName, int panelId, const TimeSlot& slot) {
-    int startSlot = timeToSlot(slot.startTime);
-    int endSlot = timeToSlot(slot.endTime);
-    
-    for (int i = startSlot; i < endSlot; i++) {
-        panelAvailability[companyName][panelId][i] = false;
+void InterviewScheduler::reservePlacements(const vector<Placement>& placements) {
+    for (const auto& i : placements) {
+        reservePanel(i.company, i.panelId, i.timeSlot);
+        reserveStudent(i.student, i.timeSlot);
     }
 }
 
-int InterviewScheduler::findAvailablePanel(const string& companyName, const TimeSlot& slot) {
-    for (int panelId = 0; panelId < companies[companyName].numPanels; panelId++) {
-        if (isPanelAvailable(companyName, panelId, slot)) {
-            return panelId;
+// Earliest start >= fromTime where the student and at least one panel of the
+// company are both free for a full round; panelId receives the one choosePanel picks
+int InterviewScheduler::findEarliestStart(int studentId, int companyId, int fromTime, int& panelId) {
+    const Company& company = companies[companyId];
+
+    if (searchStrategy == SearchStrategy::Step) {
+        // Only start times inside a free gap of the student's calendar are probed
+        for (int startTime = findStudentGap(studentId, fromTime, company.durationPerRound);
+             startTime != -1 && startTime + company.durationPerRound <= availableSlot.endTime;
+             startTime = findStudentGap(studentId, startTime + timeSlotDuration, company.durationPerRound)) {
+            panelId = findAvailablePanel(companyId, TimeSlot(startTime, startTime + company.durationPerRound));
+            if (panelId != -1) {
+                return startTime;
+            }
+        }
+        return -1;
+    }
+
+    // Jump: alternate between the student's next free gap and the next slot
+    // where some panel can take a whole round until both agree
+    const SlotBitmap& calendar = studentCalendar[studentId];
+    const vector<SlotBitmap>& panels = panelOccupancy[companyId];
+    bool useTable = (int)panels.size() >= startTablePanels;
+    int length = (company.durationPerRound + timeSlotDuration - 1) / timeSlotDuration;
+    int slot = (fromTime - availableSlot.startTime + timeSlotDuration - 1) / timeSlotDuration;
+
+    while (true) {
+        slot = calendar.findFreeRun(slot, length);
+        if (slot == -1) {
+            return -1;
+        }
+        int panelSlot = -1;
+        if (useTable) {
+            panelSlot = panelStarts[companyId].nextStart(slot);
+        } else {
+            for (const SlotBitmap& panel : panels) {
+                int candidate = panel.findFreeRun(slot, length);
+                if (candidate != -1 && (panelSlot == -1 || candidate < panelSlot)) {
+                    panelSlot = candidate;
+                    if (candidate == slot) break;
+                }
+            }
+        }
+        if (panelSlot == -1) {
+            return -1;
         }
+        if (panelSlot == slot) {
+            panelId = choosePanel(companyId, slot, slot + length);
+            return slotToTime(slot);
+        }
+        slot = panelSlot;
     }
-    return -1; // No available panel
 }
 
-bool InterviewScheduler::scheduleStudentInterviews(const string& studentId, int companyIndex, vector<Interview>& currentSchedule) {
-    if (companyIndex >= (int)students[studentId].shortlistedCompanies.size()) {
+// Charges one unit of search work to the component being solved on this
+// thread; returns false once it is out of budget. The clock is only read
+// every 256 nodes to keep the check cheap.
+bool InterviewScheduler::consumeNode() {
+    if (!activeBudget) {
         return true;
     }
+    long long nodes = ++activeBudget->nodes;
+    if ((activeBudget->limit > 0 && nodes > activeBudget->limit) ||
+        ((nodes & 255) == 0 && chrono::steady_clock::now() >= deadline)) {
+        activeBudget->exhausted = true;
+    }
+    return !activeBudget->exhausted;
+}
 
-    string companyName = students[studentId].shortlistedCompanies[companyIndex];
-    Company& company = companies[companyName];
-    vector<Interview> companyInterviews;
-    int currentTime = availableSlot.startTime;
+// Appends every round of one company for the student, the first at or after
+// fromTime and each later round after the previous one ends. On failure the
+// rounds it appended are released and removed again.
+bool InterviewScheduler::placeCompanyRounds(int studentId, int companyId, int fromTime, vector<Placement>& companyInterviews) {
+    const Company& company = companies[companyId];
+    int currentTime = fromTime;
+    size_t first = companyInterviews.size();
 
     // Try scheduling rounds sequentially
     for (int round = 1; round <= company.numRounds; round++) {
-        bool roundScheduled = false;
-        
-        for (int startTime = currentTime; 
-             startTime + company.durationPerRound <= availableSlot.endTime; 
-             startTime += timeSlotDuration) {
-            
-            TimeSlot proposedSlot(startTime, startTime + company.durationPerRound);
-            
-            if (!isStudentAvailable(studentId, proposedSlot)) continue;
-            
-            int panelId = findAvailablePanel(companyName, proposedSlot);
-            if (panelId == -1) continue;
-
-            Interview interview(studentId, companyName, round, proposedSlot, panelId);
-            companyInterviews.push_back(interview);
-            reservePanel(companyName, panelId, proposedSlot);
-            studentSchedule[studentId].push_back(proposedSlot);
-            currentTime = proposedSlot.endTime;
-            roundScheduled = true;
-            break;
-        }
+        int panelId = -1;
+        int startTime = consumeNode() ? findEarliestStart(studentId, companyId, currentTime, panelId) : -1;
 
-        if (!roundScheduled) {
+        if (startTime == -1) {
             // Backtrack - release resources for this company
-            for (auto& i : companyInterviews) {
-                releasePanel(i.companyName, i.panelId, i.timeSlot);
+            for (size_t i = first; i < companyInterviews.size(); i++) {
+                releasePanel(companyId, companyInterviews[i].panelId, companyInterviews[i].timeSlot);
+                releaseStudent(studentId, companyInterviews[i].timeSlot);
             }
-            studentSchedule[studentId].erase(
-                studentSchedule[studentId].end() - (int)companyInterviews.size(),
-                studentSchedule[studentId].end()
-            );
+            companyInterviews.resize(first);
             return false;
         }
+
+        TimeSlot proposedSlot(startTime, startTime + company.durationPerRound);
+        companyInterviews.push_back({studentId, companyId, round, proposedSlot, panelId});
+        reservePanel(companyId, panelId, proposedSlot);
+        reserveStudent(studentId, proposedSlot);
+        currentTime = proposedSlot.endTime;
     }
+    return true;
+}
 
-    // Add current company's interviews to schedule
-    for (const auto& i : companyInterviews) {
-        currentSchedule.push_back(i);
+// A company only fits where one of its panels is free, so the earlier
+// companies to blame for its failure are those booked inside that time
+void InterviewScheduler::blameBlockers(const StudentSearch& search, int companyIndex, pmr::vector<char>& culprits) {
+    const vector<SlotBitmap>& panels = panelOccupancy[shortlists[search.student][companyIndex]];
+    for (size_t i = 0; i < search.owner.size(); i++) {
+        int owner = search.owner[i];
+        if (owner >= companyIndex || culprits[owner]) continue;
+        int startSlot, endSlot;
+        slotRange(search.placements[i].timeSlot, startSlot, endSlot);
+        for (const SlotBitmap& panel : panels) {
+            if (panel.nextFree(startSlot) < endSlot) {
+                culprits[owner] = 1;
+                break;
+            }
+        }
     }
+}
 
-    // Try next company
-    if (scheduleStudentInterviews(studentId, companyIndex + 1, currentSchedule)) {
+// Books shortlist entries companyIndex.. in order, trying later first-round
+// starts for a company when everything after it fails. On failure culprits
+// marks the earlier entries responsible; if this entry is not among the
+// culprits of a deeper failure, moving it cannot help and the search jumps
+// straight back to the deepest culprit.
+bool InterviewScheduler::searchCompanies(StudentSearch& search, int companyIndex, pmr::vector<char>& culprits) {
+    const vector<int>& shortlist = shortlists[search.student];
+    if (companyIndex >= (int)shortlist.size()) {
         return true;
     }
 
-    // Backtrack - remove this company's interviews
-    for (auto& i : companyInterviews) {
-        releasePanel(i.companyName, i.panelId, i.timeSlot);
+    int companyId = shortlist[companyIndex];
+    if (search.skipSingleRound && companies[companyId].numRounds == 1) {
+        return searchCompanies(search, companyIndex + 1, culprits);
     }
-    studentSchedule[studentId].erase(
-        studentSchedule[studentId].end() - (int)companyInterviews.size(),
-        studentSchedule[studentId].end()
-    );
-    currentSchedule.erase(
-        currentSchedule.end() - (int)companyInterviews.size(),
-        currentSchedule.end()
-    );
+
+    pmr::memory_resource* scratch = search.owner.get_allocator().resource();
+    const vector<uint64_t>& calendar = studentCalendar[search.student].data();
+    pair<int, pmr::vector<uint64_t>> state(companyIndex, pmr::vector<uint64_t>(calendar.begin(), calendar.end(), scratch));
+    if (search.failedStates.count(state)) {
+        fill(culprits.begin(), culprits.begin() + companyIndex, 1);
+        return false;
+    }
+
+    pmr::vector<char> blamed(shortlist.size(), 0, scratch);
+    pmr::vector<char> deeper(scratch);
+    int fromTime = availableSlot.startTime;
+    while ((!activeBudget || !activeBudget->exhausted) && search.attempts++ < studentAttemptLimit) {
+        // This company's rounds go straight onto the end of the placements
+        size_t first = search.placements.size();
+        if (!placeCompanyRounds(search.student, companyId, fromTime, search.placements)) {
+            blameBlockers(search, companyIndex, blamed);
+            break;
+        }
+        search.owner.resize(search.placements.size(), companyIndex);
+        // A company without rounds books nothing, so it has no later start to try
+        int startTime = search.placements.size() > first ? search.placements[first].timeSlot.startTime : -1;
+
+        // Try next company
+        deeper.assign(shortlist.size(), 0);
+        if (searchCompanies(search, companyIndex + 1, deeper)) {
+            return true;
+        }
+
+        // Backtrack - remove this company's interviews
+        for (size_t i = first; i < search.placements.size(); i++) {
+            releasePanel(companyId, search.placements[i].panelId, search.placements[i].timeSlot);
+            releaseStudent(search.student, search.placements[i].timeSlot);
+        }
+        search.placements.resize(first);
+        search.owner.resize(first);
+
+        if (!deeper[companyIndex] || startTime == -1) {
+            culprits = move(deeper);
+            return false;
+        }
+        for (int j = 0; j < companyIndex; j++) {
+            blamed[j] |= deeper[j];
+        }
+        fromTime = startTime + timeSlotDuration;
+    }
+
+    // Every start for this company was tried, so this calendar is a dead end
+    if ((!activeBudget || !activeBudget->exhausted) && search.attempts <= studentAttemptLimit) {
+        search.failedStates.insert(move(state));
+    }
+    culprits = move(blamed);
     return false;
 }
 
+// skipSingleRound leaves single-round companies to matchSingleRoundCompanies.
+// Search state is allocated from scratch, which the caller may release as
+// soon as this returns.
+bool InterviewScheduler::scheduleStudentInterviews(int studentId, vector<Placement>& currentSchedule, bool skipSingleRound,
+                                                   pmr::memory_resource* scratch) {
+    StudentSearch search{studentId, skipSingleRound, currentSchedule,
+                         pmr::vector<int>(currentSchedule.size(), (int)shortlists[studentId].size(), scratch),
+                         decltype(StudentSearch::failedStates)(scratch)};
+    pmr::vector<char> culprits(shortlists[studentId].size(), 0, scratch);
+    return searchCompanies(search, 0, culprits);
+}
+
+// Places all of the student's rounds in one propagation search. Every task
+// starts where some panel is free, so the lowest free panel is taken there.
+// Like the backtracker, the search gives up on the student after
+// studentAttemptLimit nodes.
+bool InterviewScheduler::solveStudentWithPropagation(int studentId, vector<Placement>& placed, bool skipSingleRound) {
+    vector<int> groupCompany;
+    vector<ConstraintSolver::TaskGroup> groups;
+    for (int companyId : shortlists[studentId]) {
+        const Company& company = companies[companyId];
+        if (company.numRounds <= 0 || (skipSingleRound && company.numRounds == 1)) continue;
+        if (company.numPanels <= 0) {
+            return false;
+        }
+        ConstraintSolver::TaskGroup group;
+        group.rounds = company.numRounds;
+        group.length = (company.durationPerRound + timeSlotDuration - 1) / timeSlotDuration;
+        for (const SlotBitmap& panel : panelOccupancy[companyId]) {
+            group.panels.push_back(&panel);
+        }
+        groups.push_back(group);
+        groupCompany.push_back(companyId);
+    }
+
+    int attempts = 0;
+    ConstraintSolver solver(studentCalendar[studentId], move(groups), [this, &attempts]() {
+        return attempts++ < studentAttemptLimit && consumeNode();
+    });
+    vector<vector<int>> starts;
+    if (!solver.solve(starts)) {
+        return false;
+    }
+
+    for (int g = 0; g < (int)starts.size(); g++) {
+        int companyId = groupCompany[g];
+        for (int r = 0; r < (int)starts[g].size(); r++) {
+            int startTime = slotToTime(starts[g][r]);
+            TimeSlot slot(startTime, startTime + companies[companyId].durationPerRound);
+            int panelId = findAvailablePanel(companyId, slot);
+            placed.push_back({studentId, companyId, r + 1, slot, panelId});
+            reservePanel(companyId, panelId, slot);
+            reserveStudent(studentId, slot);
+        }
+    }
+    return true;
+}
+
+bool InterviewScheduler::scheduleStudent(int studentId, vector<Placement>& placed, bool skipSingleRound,
+                                         pmr::memory_resource* scratch) {
+    if (solverBackend == SolverBackend::Propagation) {
+        return solveStudentWithPropagation(studentId, placed, skipSingleRound);
+    }
+    return scheduleStudentInterviews(studentId, placed, skipSingleRound, scratch);
+}
+
+// Company-centric pass: each company of the component books round 1 for all
+// of its students, then round 2, and so on, sweeping one company's panels at
+// a time. A student who misses a round loses only that company's interviews.
+void InterviewScheduler::scheduleComponentByCompany(const vector<int>& component, vector<vector<Placement>>& placed,
+                                                    vector<char>& scheduled, vector<char>& timedOut) {
+    // (company, student) pairs grouped by company, students in component order
+    vector<pair<int, int>> applications;
+    for (int studentId : component) {
+        for (int companyId : shortlists[studentId]) {
+            if (companies[companyId].numRounds > 0) {
+                applications.push_back({companyId, studentId});
+            }
+        }
+    }
+    // Within a company, students who rank it highest pick first
+    stable_sort(applications.begin(), applications.end(), [this](const pair<int, int>& a, const pair<int, int>& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return priorityRank(a.second, a.first) < priorityRank(b.second, b.first);
+    });
+
+    // Most interview minutes per panel first, so the busiest companies get
+    // the students' calendars while they are still empty
+    vector<pair<size_t, size_t>> groups; // [begin, end) into applications
+    for (size_t begin = 0, end; begin < applications.size(); begin = end) {
+        end = begin;
+        while (end < applications.size() && applications[end].first == applications[begin].first) end++;
+        groups.push_back({begin, end});
+    }
+    auto load = [&](const pair<size_t, size_t>& group) {
+        const Company& company = companies[applications[group.first].first];
+        return (double)(group.second - group.first) * company.numRounds * company.durationPerRound / max(1, company.numPanels);
+    };
+    stable_sort(groups.begin(), groups.end(), [&](const pair<size_t, size_t>& a, const pair<size_t, size_t>& b) {
+        return load(a) > load(b);
+    });
+
+    vector<int> done;
+    for (const auto& [begin, end] : groups) {
+        int companyId = applications[begin].first;
+        const Company& company = companies[companyId];
+        vector<int> nextStart(end - begin, availableSlot.startTime);
+
+        // Admit only as many students as the panels can take through every
+        // round; the rest wait for the retry below instead of holding early
+        // rounds they cannot finish
+        int length = (company.durationPerRound + timeSlotDuration - 1) / timeSlotDuration;
+        size_t capacity = 0;
+        for (const SlotBitmap& panel : panelOccupancy[companyId]) {
+            for (int slot = panel.findFreeRun(0, length); slot != -1; slot = panel.findFreeRun(slot + length, length)) {
+                capacity++;
+            }
+        }
+        capacity /= company.numRounds;
+        for (size_t i = begin + min(capacity, end - begin); i < end; i++) {
+            nextStart[i - begin] = -1;
+        }
+
+        for (int round = 1; round <= company.numRounds; round++) {
+            for (size_t i = begin; i < end; i++) {
+                int studentId = applications[i].second;
+                int& fromTime = nextStart[i - begin];
+                if (fromTime == -1) continue;
+
+                int panelId = -1;
+                int startTime = consumeNode() ? findEarliestStart(studentId, companyId, fromTime, panelId) : -1;
+                if (startTime == -1) {
+                    // Drop the rounds this student already has with the company
+                    vector<Placement>& own = placed[studentId];
+                    auto split = stable_partition(own.begin(), own.end(),
+                                                  [companyId](const Placement& p) { return p.company != companyId; });
+                    releasePlacements(vector<Placement>(split, own.end()));
+                    own.erase(split, own.end());
+                    fromTime = -1;
+                    continue;
+                }
+
+                TimeSlot slot(startTime, startTime + company.durationPerRound);
+                placed[studentId].push_back({studentId, companyId, round, slot, panelId});
+                reservePanel(companyId, panelId, slot);
+                reserveStudent(studentId, slot);
+                fromTime = slot.endTime;
+            }
+        }
+
+        // Retry the students who missed a round, one at a time, in whatever
+        // panel time the sweep left free
+        for (size_t i = begin; i < end; i++) {
+            if (nextStart[i - begin] != -1) continue;
+            int studentId = applications[i].second;
+            vector<Placement> companyInterviews;
+            if (placeCompanyRounds(studentId, companyId, availableSlot.startTime, companyInterviews)) {
+                placed[studentId].insert(placed[studentId].end(), companyInterviews.begin(), companyInterviews.end());
+            }
+        }
+        if (activeBudget && activeBudget->exhausted) break;
+        done.push_back(companyId);
+    }
+    sort(done.begin(), done.end());
+
+    // Students with a company the budget never reached are dropped entirely
+    for (int studentId : component) {
+        int expected = 0;
+        bool reached = true;
+        for (int companyId : shortlists[studentId]) {
+            expected += companies[companyId].numRounds;
+            if (companies[companyId].numRounds > 0 && !binary_search(done.begin(), done.end(), companyId)) {
+                reached = false;
+            }
+        }
+        if (!reached) {
+            releasePlacements(placed[studentId]);
+            placed[studentId].clear();
+            timedOut[studentId] = 1;
+        }
+        scheduled[studentId] = reached && (int)placed[studentId].size() == expected;
+    }
+}
+
+// Books one interview of a single-round company for every candidate at once.
+// The day is cut into a grid of back-to-back starts one interview apart;
+// each start is a node that takes as many students as there are panels free
+// for the whole interview there, and since the grid's blocks never overlap,
+// any assignment within those capacities can be booked as it is. A student
+// is joined to their first matchStartsPerStudent free starts with the start
+// slot as cost, and students with the same starts share one node, so the
+// min-cost flow stays small however large the cohort. Students left over are
+// matched again on the grid shifted by one slot, up to one interview length.
+// matched[i] tells whether candidates[i] got a start; returns false if the
+// search budget ran out first.
+bool InterviewScheduler::matchCompany(int companyId, const vector<int>& candidates,
+                                      vector<vector<Placement>>& placed, vector<char>& matched) {
+    const Company& company = companies[companyId];
+    const vector<SlotBitmap>& panels = panelOccupancy[companyId];
+    int length = (company.durationPerRound + timeSlotDuration - 1) / timeSlotDuration;
+    int totalSlots = getTotalSlots();
+
+    matched.assign(candidates.size(), 0);
+    vector<int> waiting(candidates.size()); // indexes into candidates
+    iota(waiting.begin(), waiting.end(), 0);
+    bool complete = true;
+    vector<uint64_t> starts;
+    for (int offset = 0; offset < length && !waiting.empty() && complete; offset++) {
+        // Grid starts offset, offset + length, ... with at least one free panel
+        vector<int> gridSlots;
+        vector<int> capacity;
+        vector<int> counts((totalSlots - offset) / length, 0);
+        for (const SlotBitmap& panel : panels) {
+            panel.freeRunStarts(length, starts);
+            for (int k = 0; k < (int)counts.size(); k++) {
+                int slot = offset + k * length;
+                counts[k] += (int)(starts[slot >> 6] >> (slot & 63)) & 1;
+            }
+        }
+        for (int k = 0; k < (int)counts.size(); k++) {
+            if (counts[k] > 0) {
+                gridSlots.push_back(offset + k * length);
+                capacity.push_back(counts[k]);
+            }
+        }
+        if (gridSlots.empty()) continue;
+
+        // Waiting students grouped by the grid starts open to them
+        map<vector<int>, int> groupOf;
+        vector<vector<int>> groupStarts;
+        vector<vector<int>> groupMembers; // indexes into candidates, in candidate order
+        for (int i : waiting) {
+            const SlotBitmap& calendar = studentCalendar[candidates[i]];
+            vector<int> open;
+            for (int g = 0; g < (int)gridSlots.size() && (int)open.size() < matchStartsPerStudent; g++) {
+                if (calendar.isFree(gridSlots[g], gridSlots[g] + length)) {
+                    open.push_back(g);
+                }
+            }
+            if (open.empty()) continue;
+            auto [it, added] = groupOf.insert({open, (int)groupStarts.size()});
+            if (added) {
+                groupStarts.push_back(open);
+                groupMembers.emplace_back();
+            }
+            groupMembers[it->second].push_back(i);
+        }
+
+        int numGroups = (int)groupStarts.size();
+        int source = numGroups + (int)gridSlots.size();
+        int sink = source + 1;
+        MinCostFlow network(sink + 1);
+        vector<vector<int>> groupEdges(numGroups);
+        for (int g = 0; g < numGroups; g++) {
+            int size = (int)groupMembers[g].size();
+            network.addEdge(source, g, size, 0);
+            for (int start : groupStarts[g]) {
+                groupEdges[g].push_back(network.addEdge(g, numGroups + start, size, gridSlots[start]));
+            }
+        }
+        for (int start = 0; start < (int)gridSlots.size(); start++) {
+            network.addEdge(numGroups + start, sink, capacity[start], 0);
+        }
+
+        network.solve(source, sink, [&]() {
+            complete = consumeNode();
+            return complete;
+        });
+
+        // Members of a group take its matched starts earliest first
+        for (int g = 0; g < numGroups; g++) {
+            size_t member = 0;
+            for (int e = 0; e < (int)groupEdges[g].size(); e++) {
+                int startSlot = gridSlots[groupStarts[g][e]];
+                for (int f = network.flow(groupEdges[g][e]); f > 0; f--) {
+                    int i = groupMembers[g][member++];
+                    int panelId = choosePanel(companyId, startSlot, startSlot + length);
+                    if (panelId == -1) continue;
+                    int startTime = slotToTime(startSlot);
+                    TimeSlot slot(startTime, startTime + company.durationPerRound);
+                    placed[candidates[i]].push_back({candidates[i], companyId, 1, slot, panelId});
+                    reservePanel(companyId, panelId, slot);
+                    reserveStudent(candidates[i], slot);
+                    matched[i] = 1;
+                }
+            }
+        }
+        waiting.erase(remove_if(waiting.begin(), waiting.end(), [&](int i) { return matched[i]; }), waiting.end());
+    }
+    return complete;
+}
+
+// Second phase of generateSchedule when single-round matching is on: every
+// student whose multi-round companies are booked is matched company by
+// company. A student the matching leaves out is placed at their earliest
+// free start as in the greedy pass; only a student who fits nowhere loses
+// all of their interviews.
+void InterviewScheduler::matchSingleRoundCompanies(const vector<int>& component, vector<vector<Placement>>& placed,
+                                                   vector<char>& scheduled, vector<char>& timedOut) {
+    vector<int> singleRound;
+    for (int studentId : component) {
+        for (int companyId : shortlists[studentId]) {
+            if (companies[companyId].numRounds == 1) {
+                singleRound.push_back(companyId);
+            }
+        }
+    }
+    sort(singleRound.begin(), singleRound.end());
+    singleRound.erase(unique(singleRound.begin(), singleRound.end()), singleRound.end());
+
+    for (int companyId : singleRound) {
+        vector<int> candidates;
+        for (int studentId : component) {
+            const vector<int>& shortlist = shortlists[studentId];
+            if (scheduled[studentId] && find(shortlist.begin(), shortlist.end(), companyId) != shortlist.end()) {
+                candidates.push_back(studentId);
+            }
+        }
+
+        vector<char> matched;
+        bool complete = matchCompany(companyId, candidates, placed, matched);
+        for (int i = 0; i < (int)candidates.size(); i++) {
+            if (matched[i]) continue;
+            int studentId = candidates[i];
+            if (complete && placeCompanyRounds(studentId, companyId, availableSlot.startTime, placed[studentId])) continue;
+            releasePlacements(placed[studentId]);
+            placed[studentId].clear();
+            scheduled[studentId] = 0;
+            timedOut[studentId] = !complete || (activeBudget && activeBudget->exhausted);
+        }
+    }
+}
+
+Interview InterviewScheduler::toInterview(const Placement& placement) const {
+    return Interview(studentIds.name(placement.student), companyIds.name(placement.company),
+                     placement.round, placement.timeSlot, placement.panelId);
+}
+
+void InterviewScheduler::setSearchStrategy(SearchStrategy strategy) {
+    searchStrategy = strategy;
+}
+
+// 0 = one per hardware thread; at most maxWorkerThreads
+void InterviewScheduler::setWorkerThreads(int threads) {
+    workerThreads = clamp(threads, 0, maxWorkerThreads);
+}
+
+void InterviewScheduler::setStudentOrdering(StudentOrdering order, uint64_t seed) {
+    ordering = order;
+    orderingSeed = seed;
+}
+
+// The random ordering shuffles with it and portfolio members use seed + index
+void InterviewScheduler::setSeed(uint64_t seed) {
+    orderingSeed = seed;
+}
+
+void InterviewScheduler::setDeadline(chrono::steady_clock::time_point until) {
+    deadline = until;
+}
+
+void InterviewScheduler::setNodeBudget(long long nodes) {
+    nodeBudget = nodes;
+}
+
+void InterviewScheduler::setLocalSearch(bool enabled) {
+    localSearch = enabled;
+}
+
+void InterviewScheduler::setSolverBackend(SolverBackend backend) {
+    solverBackend = backend;
+}
+
+void InterviewScheduler::setSingleRoundMatching(bool enabled) {
+    singleRoundMatching = enabled;
+}
+
+void InterviewScheduler::setSchedulingMode(SchedulingMode mode) {
+    schedulingMode = mode;
+}
+
+// Any objective but Feasible runs the improvement passes after generation
+void InterviewScheduler::setObjective(Objective goal) {
+    objective = goal;
+}
+
+// 0 restores the automatic choice; takes effect at the next generateSchedule
+void InterviewScheduler::setTimeSlotDuration(int minutes) {
+    requestedSlotDuration = max(0, minutes);
+}
+
 void InterviewScheduler::initialize(const TimeSlot& slot) {
-    availableSlot = slot;
+    initialize(vector<TimeSlot>{slot});
+}
+
+// One window per day in absolute minutes; the time between them is closed
+void InterviewScheduler::initialize(const vector<TimeSlot>& days) {
+    dayWindows = days;
+    sort(dayWindows.begin(), dayWindows.end(),
+         [](const TimeSlot& a, const TimeSlot& b) { return a.startTime < b.startTime; });
+    breaks.clear();
+    availableSlot = dayWindows.empty() ? TimeSlot() : TimeSlot(dayWindows.front().startTime, dayWindows.front().endTime);
+    for (const auto& day : dayWindows) {
+        availableSlot.endTime = max(availableSlot.endTime, day.endTime);
+    }
+    resetOccupancy();
+}
+
+// Availability changes take effect at the next generateSchedule
+void InterviewScheduler::addBreak(const TimeSlot& slot) {
+    breaks.push_back(slot);
+}
+
+bool InterviewScheduler::setCompanyAvailability(const string& companyName, const vector<TimeSlot>& windows) {
+    int companyId = companyIds.find(companyName);
+    if (companyId == -1) {
+        return false;
+    }
+    companyWindows[companyId] = windows;
+    return true;
+}
+
+bool InterviewScheduler::setPanelAvailability(const string& companyName, int panelId, const vector<TimeSlot>& windows) {
+    int companyId = companyIds.find(companyName);
+    if (companyId == -1 || panelId < 0 || panelId >= companies[companyId].numPanels) {
+        return false;
+    }
+    panelWindows[companyId][panelId] = windows;
+    return true;
+}
+
+// slotDuration = 0 resolves the slot length from the inputs
+void InterviewScheduler::resetOccupancy(int slotDuration) {
     schedule.clear();
-    panelAvailability.clear();
-    studentSchedule.clear();
+    studentScheduled.assign(students.size(), 0);
+    timeSlotDuration = slotDuration > 0 ? slotDuration : resolveSlotDuration();
+    int totalSlots = getTotalSlots();
+
+    // Closed time is reserved up front, so the search never sees it
+    blockedSlots = SlotBitmap(totalSlots);
+    blockOutside(blockedSlots, dayWindows);
+    for (const auto& slot : breaks) {
+        int startSlot, endSlot;
+        slotRange(slot, startSlot, endSlot);
+        blockedSlots.reserve(startSlot, endSlot);
+    }
+
+    for (int companyId = 0; companyId < (int)companies.size(); companyId++) {
+        panelOccupancy[companyId].assign(companies[companyId].numPanels, blockedSlots);
+        panelMinutes[companyId].assign(companies[companyId].numPanels, 0);
+        for (int panelId = 0; panelId < companies[companyId].numPanels; panelId++) {
+            SlotBitmap& panel = panelOccupancy[companyId][panelId];
+            if (!companyWindows[companyId].empty()) {
+                blockOutside(panel, companyWindows[companyId]);
+            }
+            if (!panelWindows[companyId][panelId].empty()) {
+                blockOutside(panel, panelWindows[companyId][panelId]);
+            }
+            // Dropped panels stay blocked for the whole window
+            if (panelDropped[companyId][panelId]) {
+                panel.reserve(0, totalSlots);
+            }
+        }
+        indexPanels(companyId);
+    }
+    for (int studentId = 0; studentId < (int)students.size(); studentId++) {
+        rebuildStudentCalendar(studentId);
+    }
 }
 
 void InterviewScheduler::addCompany(const string& name, int duration, int rounds, int panels) {
-    companies[name] = Company(name, duration, rounds, panels);
-    int totalSlots = getTotalSlots();
-    panelAvailability[name] = vector<vector<bool>>(panels, vector<bool>(totalSlots, false));
+    int companyId = companyIds.intern(name);
+    if (companyId == (int)companies.size()) {
+        companies.emplace_back();
+        panelOccupancy.emplace_back();
+        panelMatrix.emplace_back();
+        panelStarts.emplace_back();
+        panelMinutes.emplace_back();
+        panelDropped.emplace_back();
+        companyWindows.emplace_back();
+        panelWindows.emplace_back();
+    }
+    companies[companyId] = Company(name, duration, rounds, panels);
+    panelOccupancy[companyId].assign(panels, blockedSlots);
+    indexPanels(companyId);
+    panelMinutes[companyId].assign(panels, 0);
+    panelDropped[companyId].assign(panels, 0);
+    companyWindows[companyId].clear();
+    panelWindows[companyId].assign(panels, vector<TimeSlot>());
 }
 
 void InterviewScheduler::addStudent(const std::string& rollNumber, const std::string& name, const std::vector<std::string>& shortlistedCompanies) {
-    students[rollNumber] = Student(rollNumber, name);
-    students[rollNumber].shortlistedCompanies = shortlistedCompanies;
+    Student student(rollNumber, name);
+    student.shortlistedCompanies = shortlistedCompanies;
+    addStudent(student);
+}
+
+void InterviewScheduler::addStudent(const Student& student) {
+    int studentId = studentIds.intern(student.rollNumber);
+    if (studentId == (int)students.size()) {
+        students.emplace_back();
+        shortlists.emplace_back();
+        priorityCount.push_back(0);
+        studentScheduled.push_back(0);
+        studentCalendar.push_back(blockedSlots);
+    }
+    students[studentId] = student;
+
+    // Companies not added (yet) resolve to an empty placeholder with no rounds
+    vector<int>& shortlist = shortlists[studentId];
+    shortlist.clear();
+    for (const auto& companyName : student.shortlistedCompanies) {
+        int companyId = companyIds.intern(companyName);
+        if (companyId == (int)companies.size()) {
+            companies.emplace_back(companyName);
+            panelOccupancy.emplace_back();
+            panelMatrix.emplace_back();
+            panelStarts.emplace_back();
+            panelMinutes.emplace_back();
+            panelDropped.emplace_back();
+            companyWindows.emplace_back();
+            panelWindows.emplace_back();
+        }
+        shortlist.push_back(companyId);
+    }
+
+    // Priority companies move to the front, most wanted first, so the search
+    // books them while the student's calendar is still open
+    int front = 0;
+    for (const auto& companyName : student.priorities) {
+        auto it = find(shortlist.begin() + front, shortlist.end(), companyIds.find(companyName));
+        if (it != shortlist.end()) {
+            rotate(shortlist.begin() + front, it, it + 1);
+            front++;
+        }
+    }
+    priorityCount[studentId] = front;
+    rebuildStudentCalendar(studentId);
+}
+
+// Closed hours, the student's own unavailability and their booked interviews
+void InterviewScheduler::rebuildStudentCalendar(int studentId) {
+    SlotBitmap& calendar = studentCalendar[studentId];
+    calendar = blockedSlots;
+    for (const auto& slot : students[studentId].unavailable) {
+        int startSlot, endSlot;
+        slotRange(slot, startSlot, endSlot);
+        calendar.reserve(startSlot, endSlot);
+    }
+    for (const auto& p : schedule) {
+        if (p.student == studentId) {
+            reserveStudent(studentId, p.timeSlot);
+        }
+    }
+}
+
+// Position of the company in the student's priorities, or INT_MAX
+int InterviewScheduler::priorityRank(int studentId, int companyId) const {
+    const vector<int>& shortlist = shortlists[studentId];
+    for (int i = 0; i < priorityCount[studentId]; i++) {
+        if (shortlist[i] == companyId) {
+            return i;
+        }
+    }
+    return INT_MAX;
+}
+
+
+// Splits students into connected components of the student-company shortlist
+// graph. Each component keeps the relative order of `order`, and components
+// are returned largest first.
+vector<vector<int>> InterviewScheduler::partitionComponents(const vector<int>& order) {
+    vector<int> parent(companies.size());
+    for (int c = 0; c < (int)parent.size(); c++) {
+        parent[c] = c;
+    }
+    auto find = [&parent](int c) {
+        while (parent[c] != c) {
+            c = parent[c] = parent[parent[c]];
+        }
+        return c;
+    };
+
+    for (const auto& shortlist : shortlists) {
+        for (size_t i = 1; i < shortlist.size(); i++) {
+            parent[find(shortlist[i])] = find(shortlist[0]);
+        }
+    }
+
+    // Students without companies have nothing to book and form their own group
+    vector<int> componentOf(companies.size() + 1, -1);
+    vector<vector<int>> components;
+    for (int studentId : order) {
+        int root = shortlists[studentId].empty() ? (int)companies.size() : find(shortlists[studentId][0]);
+        if (componentOf[root] == -1) {
+            componentOf[root] = (int)components.size();
+            components.emplace_back();
+        }
+        components[componentOf[root]].push_back(studentId);
+    }
+
+    stable_sort(components.begin(), components.end(),
+                [](const vector<int>& a, const vector<int>& b) { return a.size() > b.size(); });
+    return components;
 }
 
+// splitmix64 step; used instead of <random> so shuffles are identical on every platform
+static uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+vector<int> InterviewScheduler::orderStudents() {
+    vector<int> order(students.size());
+    for (int id = 0; id < (int)order.size(); id++) {
+        order[id] = id;
+    }
+    auto byName = [this](int a, int b) { return studentIds.name(a) < studentIds.name(b); };
+
+    if (ordering == StudentOrdering::Randomized) {
+        // Shuffle from the name-sorted order so the result only depends on the seed
+        sort(order.begin(), order.end(), byName);
+        uint64_t state = orderingSeed;
+        for (int i = (int)order.size() - 1; i > 0; i--) {
+            swap(order[i], order[nextRandom(state) % (i + 1)]);
+        }
+        return order;
+    }
+
+    // Higher key = scheduled earlier, except for FewestShortlists
+    vector<double> key(students.size(), 0.0);
+    if (ordering == StudentOrdering::FewestShortlists) {
+        for (int id = 0; id < (int)key.size(); id++) {
+            key[id] = -(double)shortlists[id].size();
+        }
+    } else if (ordering == StudentOrdering::MostConstrained) {
+        for (int id = 0; id < (int)key.size(); id++) {
+            for (int companyId : shortlists[id]) {
+                key[id] += companies[companyId].numRounds * companies[companyId].durationPerRound;
+            }
+            // Time the student is away shrinks their day just like interviews
+            for (const auto& slot : students[id].unavailable) {
+                key[id] += slot.endTime - slot.startTime;
+            }
+        }
+    } else {
+        // Demand on each company relative to the panel minutes it offers
+        vector<double> demand(companies.size(), 0.0);
+        for (const auto& shortlist : shortlists) {
+            for (int companyId : shortlist) {
+                demand[companyId] += companies[companyId].numRounds * companies[companyId].durationPerRound;
+            }
+        }
+        // Panel time actually open, after hours, breaks and dropped panels
+        for (int companyId = 0; companyId < (int)companies.size(); companyId++) {
+            double open = 0.0;
+            for (const SlotBitmap& panel : panelOccupancy[companyId]) {
+                open += panel.freeCount();
+            }
+            demand[companyId] /= max(1.0, open * timeSlotDuration);
+        }
+        for (int id = 0; id < (int)key.size(); id++) {
+            for (int companyId : shortlists[id]) {
+                key[id] = max(key[id], demand[companyId]);
+            }
+        }
+    }
+
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        if (key[a] != key[b]) {
+            return key[a] > key[b];
+        }
+        return byName(a, b);
+    });
+    return order;
+}
+
+int InterviewScheduler::computeMakespan() const {
+    int makespan = 0;
+    for (const auto& i : schedule) {
+        makespan = max(makespan, i.timeSlot.endTime);
+    }
+    return makespan;
+}
 
 vector<string> InterviewScheduler::generateSchedule() {
     vector<string> conflicts;
+    resetOccupancy();
+    vector<int> studentOrder = orderStudents();
 
-    // Sort students by fewest shortlisted companies first (greedy)
-    vector<pair<int, string>> studentOrder;
-    for (const auto& student : students) {
-        studentOrder.push_back({(int)student.second.shortlistedCompanies.size(), student.first});
+    // Components share no company or student, so each can be solved on its
+    // own thread; results are merged back in the global student order
+    vector<vector<int>> components = partitionComponents(studentOrder);
+    vector<vector<Placement>> placed(students.size());
+    vector<char> scheduled(students.size(), 0);
+    vector<char> timedOut(students.size(), 0);
+
+    // Once a component's budget runs out, the student being searched is
+    // rolled back and the rest are skipped, leaving every fully placed student
+    // in the result. The node budget is shared out by shortlist entries.
+    vector<SearchBudget> budgets(components.size());
+    if (nodeBudget > 0) {
+        vector<long long> weight(components.size(), 0);
+        long long totalWeight = 0;
+        for (int c = 0; c < (int)components.size(); c++) {
+            for (int studentId : components[c]) {
+                weight[c] += (long long)shortlists[studentId].size() + 1;
+            }
+            totalWeight += weight[c];
+        }
+        for (int c = 0; c < (int)components.size(); c++) {
+            budgets[c].limit = max(1LL, nodeBudget / totalWeight * weight[c] + nodeBudget % totalWeight * weight[c] / totalWeight);
+        }
+    }
+    bool improve = localSearch || objective != Objective::Feasible;
+    vector<unique_ptr<SearchArena>> arenas;
+    for (int w = resolveWorkerCount(workerThreads, (int)components.size()); w > 0; w--) {
+        arenas.push_back(make_unique<SearchArena>(searchArenaBytes));
+    }
+    parallelForWorkers((int)components.size(), workerThreads, [&](int worker, int c) {
+        SearchBudget& budget = budgets[c];
+        activeBudget = &budget;
+        if (schedulingMode == SchedulingMode::CompanyCentric) {
+            scheduleComponentByCompany(components[c], placed, scheduled, timedOut);
+            if (improve && !budget.exhausted) {
+                improveComponent(components[c], placed, scheduled, localSearch);
+            }
+            activeBudget = nullptr;
+            return;
+        }
+        auto solveStudents = [&](bool skipSingleRound) {
+            for (int studentId : components[c]) {
+                if (!budget.exhausted && chrono::steady_clock::now() >= deadline) {
+                    budget.exhausted = true;
+                }
+                if (!budget.exhausted) {
+                    scheduled[studentId] = scheduleStudent(studentId, placed[studentId], skipSingleRound,
+                                                           &arenas[worker]->resource);
+                    arenas[worker]->release();
+                }
+                timedOut[studentId] = !scheduled[studentId] && budget.exhausted;
+            }
+        };
+        solveStudents(false);
+
+        // Matching usually fits more students into single-round companies,
+        // but its grid can leave out some that the greedy pass places, so the
+        // greedy result is kept whenever it places more students
+        bool match = singleRoundMatching && any_of(components[c].begin(), components[c].end(), [&](int studentId) {
+            return any_of(shortlists[studentId].begin(), shortlists[studentId].end(),
+                          [&](int companyId) { return companies[companyId].numRounds == 1; });
+        });
+        if (match && !budget.exhausted) {
+            vector<vector<Placement>> greedy;
+            vector<char> greedyScheduled;
+            int greedyPlaced = 0;
+            for (int studentId : components[c]) {
+                releasePlacements(placed[studentId]);
+                greedy.push_back(move(placed[studentId]));
+                placed[studentId].clear();
+                greedyScheduled.push_back(scheduled[studentId]);
+                greedyPlaced += scheduled[studentId];
+            }
+            solveStudents(true);
+            matchSingleRoundCompanies(components[c], placed, scheduled, timedOut);
+            int matchedPlaced = 0;
+            for (int studentId : components[c]) {
+                matchedPlaced += scheduled[studentId];
+            }
+            if (budget.exhausted || matchedPlaced < greedyPlaced) {
+                for (size_t i = 0; i < components[c].size(); i++) {
+                    int studentId = components[c][i];
+                    releasePlacements(placed[studentId]);
+                    placed[studentId] = move(greedy[i]);
+                    reservePlacements(placed[studentId]);
+                    scheduled[studentId] = greedyScheduled[i];
+                    timedOut[studentId] = 0;
+                }
+                budget.exhausted = false;
+            }
+        }
+        if (improve && !budget.exhausted) {
+            improveComponent(components[c], placed, scheduled, localSearch);
+        }
+        activeBudget = nullptr;
+    });
+
+    lastRunStats = ScheduleStats();
+    lastRunStats.studentsTotal = (int)students.size();
+    for (const auto& budget : budgets) {
+        lastRunStats.nodesExplored += budget.nodes;
+        lastRunStats.budgetExhausted = lastRunStats.budgetExhausted || budget.exhausted;
+    }
+
+    for (int studentId : studentOrder) {
+        if (timedOut[studentId]) {
+            conflicts.push_back("Search budget exhausted before scheduling student " + studentIds.name(studentId));
+            continue;
+        }
+        if (!scheduled[studentId] && schedulingMode == SchedulingMode::CompanyCentric) {
+            // Partly placed students keep the companies that fit
+            vector<char> booked(companies.size(), 0);
+            for (const auto& p : placed[studentId]) {
+                booked[p.company] = 1;
+            }
+            for (int companyId : shortlists[studentId]) {
+                if (!booked[companyId] && companies[companyId].numRounds > 0) {
+                    booked[companyId] = 1;
+                    conflicts.push_back("Cannot schedule " + companyIds.name(companyId) + " for student " + studentIds.name(studentId));
+                }
+            }
+            schedule.append(placed[studentId]);
+            continue;
+        }
+        if (!scheduled[studentId]) {
+            conflicts.push_back("Cannot schedule all interviews for student " + studentIds.name(studentId));
+            continue;
+        }
+
+        lastRunStats.studentsPlaced++;
+        studentScheduled[studentId] = 1;
+        schedule.append(placed[studentId]);
+    }
+    indexSchedule();
+
+    return conflicts;
+}
+
+// Runs several orderings side by side and keeps the schedule with the fewest
+// conflicts, breaking ties by the objective's cost, then by makespan and then
+// by member index. At most maxPortfolioSize members are run.
+PortfolioResult InterviewScheduler::generatePortfolioSchedule(int size, chrono::milliseconds timeBudget) {
+    size = clamp(size, 1, maxPortfolioSize);
+    auto until = timeBudget.count() > 0 ? chrono::steady_clock::now() + timeBudget : deadline;
+
+    const StudentOrdering fixedOrders[] = {
+        StudentOrdering::FewestShortlists, StudentOrdering::MostConstrained, StudentOrdering::CapacityRatio
+    };
+    vector<InterviewScheduler> members(size, *this);
+    vector<vector<string>> memberConflicts(size);
+    for (int m = 0; m < size; m++) {
+        if (m < 3) {
+            members[m].setStudentOrdering(fixedOrders[m]);
+        } else {
+            members[m].setStudentOrdering(StudentOrdering::Randomized, orderingSeed + m);
+        }
+        members[m].setWorkerThreads(1);
+        members[m].setDeadline(until);
+    }
+
+    parallelFor(size, workerThreads, [&](int m) {
+        memberConflicts[m] = members[m].generateSchedule();
+    });
+
+    int best = 0;
+    vector<int> makespans(size);
+    vector<ScheduleCost> costs(size);
+    for (int m = 0; m < size; m++) {
+        makespans[m] = members[m].computeMakespan();
+        if (objective != Objective::Feasible) {
+            costs[m] = members[m].costModel().cost();
+        }
+        auto rank = [&](int i) {
+            return make_tuple(memberConflicts[i].size(), costs[i].primary, costs[i].secondary, makespans[i]);
+        };
+        if (rank(m) < rank(best)) {
+            best = m;
+        }
+    }
+
+    // The winner's bitmaps are laid out in the slot length it resolved, which
+    // later edits on this scheduler must keep using
+    InterviewScheduler& winner = members[best];
+    timeSlotDuration = winner.timeSlotDuration;
+    blockedSlots = move(winner.blockedSlots);
+    schedule = move(winner.schedule);
+    panelOccupancy = move(winner.panelOccupancy);
+    panelMatrix = move(winner.panelMatrix);
+    panelStarts = move(winner.panelStarts);
+    panelMinutes = move(winner.panelMinutes);
+    studentCalendar = move(winner.studentCalendar);
+    studentScheduled = move(winner.studentScheduled);
+    lastRunStats = winner.lastRunStats;
+
+    PortfolioResult result;
+    result.conflicts = move(memberConflicts[best]);
+    result.ordering = winner.ordering;
+    result.seed = winner.orderingSeed;
+    result.makespan = makespans[best];
+    result.members = size;
+    return result;
+}
+
+vector<string> InterviewScheduler::restoreSchedule(const vector<Interview>& interviews) {
+    vector<string> conflicts;
+    // The schedule may predate a withdrawn company whose duration set a finer grid
+    int slotDuration = resolveSlotDuration();
+    if (requestedSlotDuration == 0) {
+        for (const auto& interview : interviews) {
+            slotDuration = gcd(slotDuration, interview.timeSlot.startTime - availableSlot.startTime);
+            slotDuration = gcd(slotDuration, interview.timeSlot.endTime - availableSlot.startTime);
+        }
+    }
+    resetOccupancy(max(1, slotDuration));
+    int totalSlots = getTotalSlots();
+
+    // booked[student][company] = rounds restored so far, in order
+    vector<vector<int>> booked(students.size(), vector<int>(companies.size(), 0));
+    vector<TimeSlot> lastRound(students.size() * companies.size());
+    for (const auto& interview : interviews) {
+        int studentId = studentIds.find(interview.studentId);
+        int companyId = companyIds.find(interview.companyName);
+        string label = interview.companyName + " round " + to_string(interview.round) + " for student " + interview.studentId;
+        if (studentId == -1 || companyId == -1 ||
+            find(shortlists[studentId].begin(), shortlists[studentId].end(), companyId) == shortlists[studentId].end()) {
+            conflicts.push_back("Cannot restore " + label + ": not shortlisted");
+            continue;
+        }
+        const Company& company = companies[companyId];
+        const TimeSlot& slot = interview.timeSlot;
+        int startSlot, endSlot;
+        slotRange(slot, startSlot, endSlot);
+        int& rounds = booked[studentId][companyId];
+        TimeSlot& previous = lastRound[studentId * companies.size() + companyId];
+        if (interview.round != rounds + 1 || interview.round > company.numRounds ||
+            (rounds > 0 && previous.endTime > slot.startTime)) {
+            conflicts.push_back("Cannot restore " + label + ": rounds out of order");
+            continue;
+        }
+        if (slot.endTime - slot.startTime != company.durationPerRound || slot.startTime < availableSlot.startTime ||
+            endSlot > totalSlots || interview.panelId < 0 || interview.panelId >= company.numPanels ||
+            !isPanelAvailable(companyId, interview.panelId, slot) || !isStudentAvailable(studentId, slot)) {
+            conflicts.push_back("Cannot restore " + label + ": slot not available");
+            continue;
+        }
+
+        reservePanel(companyId, interview.panelId, slot);
+        reserveStudent(studentId, slot);
+        schedule.push_back({studentId, companyId, interview.round, slot, interview.panelId});
+        rounds++;
+        previous = slot;
+    }
+
+    lastRunStats = ScheduleStats();
+    lastRunStats.studentsTotal = (int)students.size();
+    for (int studentId = 0; studentId < (int)students.size(); studentId++) {
+        bool complete = true;
+        for (int companyId : shortlists[studentId]) {
+            complete = complete && booked[studentId][companyId] >= companies[companyId].numRounds;
+        }
+        studentScheduled[studentId] = complete;
+        if (complete) {
+            lastRunStats.studentsPlaced++;
+        } else {
+            conflicts.push_back("Cannot schedule all interviews for student " + studentIds.name(studentId));
+        }
+    }
+    indexSchedule();
+    return conflicts;
+}
+
+// Removes and releases every scheduled interview matching pred, returning them
+template <typename Pred>
+vector<InterviewScheduler::Placement> InterviewScheduler::unschedule(Pred pred) {
+    vector<Placement> removed = schedule.extract(pred);
+    releasePlacements(removed);
+    return removed;
+}
+
+// A student who missed a company after an edit keeps none of their
+// interviews, as in generateSchedule; company-centric schedules keep the
+// companies that fit
+void InterviewScheduler::dropIncompleteStudent(int studentId, vector<string>& conflicts) {
+    studentScheduled[studentId] = 0;
+    if (schedulingMode == SchedulingMode::StudentCentric) {
+        unschedule([studentId](const Placement& p) { return p.student == studentId; });
+        conflicts.push_back("Cannot schedule all interviews for student " + studentIds.name(studentId));
+    }
+}
+
+vector<string> InterviewScheduler::addLateStudent(const string& rollNumber, const string& name, const vector<string>& shortlistedCompanies) {
+    Student student(rollNumber, name);
+    student.shortlistedCompanies = shortlistedCompanies;
+    return addLateStudent(student);
+}
+
+vector<string> InterviewScheduler::addLateStudent(const Student& student) {
+    int studentId = studentIds.find(student.rollNumber);
+    if (studentId != -1) {
+        withdrawStudent(student.rollNumber);
+    }
+    addStudent(student);
+    studentId = studentIds.find(student.rollNumber);
+
+    vector<Placement> placed;
+    if (!scheduleStudent(studentId, placed)) {
+        return {"Cannot schedule all interviews for student " + student.rollNumber};
+    }
+    schedule.append(placed);
+    studentScheduled[studentId] = 1;
+    indexSchedule();
+    return {};
+}
+
+vector<string> InterviewScheduler::addLateShortlist(const string& rollNumber, const string& companyName) {
+    int studentId = studentIds.find(rollNumber);
+    if (studentId == -1) {
+        return {"Unknown student " + rollNumber};
+    }
+    int companyId = companyIds.find(companyName);
+    if (companyId == -1) {
+        return {"Unknown company " + companyName};
+    }
+    // A second entry would book the company twice on the next generation
+    if (find(shortlists[studentId].begin(), shortlists[studentId].end(), companyId) != shortlists[studentId].end()) {
+        return {"Company " + companyName + " is already shortlisted for student " + rollNumber};
+    }
+
+    students[studentId].shortlistedCompanies.push_back(companyName);
+    shortlists[studentId].push_back(companyId);
+
+    // Books the new company, plus any the student is still missing from an
+    // earlier failed attempt; interviews already on the schedule stay put
+    vector<char> booked(companies.size(), 0);
+    for (const auto& p : schedule) {
+        if (p.student == studentId) {
+            booked[p.company] = 1;
+        }
     }
-    sort(studentOrder.begin(), studentOrder.end());
 
-    for (const auto& studentPair : studentOrder) {
-        string studentId = studentPair.second;
-        vector<Interview> studentInterviews;
-        
-        if (!scheduleStudentInterviews(studentId, 0, studentInterviews)) {
-            conflicts.push_back("Cannot schedule all interviews for student " + studentId);
+    vector<string> conflicts;
+    for (int shortlisted : shortlists[studentId]) {
+        if (booked[shortlisted]) continue;
+        booked[shortlisted] = 1;
+        vector<Placement> placed;
+        if (!placeCompanyRounds(studentId, shortlisted, availableSlot.startTime, placed)) {
+            conflicts.push_back("Cannot schedule " + companyIds.name(shortlisted) + " for student " + rollNumber);
             continue;
         }
+        schedule.append(placed);
+    }
+    studentScheduled[studentId] = conflicts.empty();
+    if (!conflicts.empty()) {
+        dropIncompleteStudent(studentId, conflicts);
+    }
+    indexSchedule();
+    return conflicts;
+}
 
-        for (const auto& i : studentInterviews) {
-            schedule.push_back(i);
+vector<string> InterviewScheduler::withdrawStudent(const string& rollNumber) {
+    int studentId = studentIds.find(rollNumber);
+    if (studentId == -1) {
+        return {"Unknown student " + rollNumber};
+    }
+    unschedule([studentId](const Placement& p) { return p.student == studentId; });
+    students[studentId].shortlistedCompanies.clear();
+    students[studentId].priorities.clear();
+    shortlists[studentId].clear();
+    priorityCount[studentId] = 0;
+    studentScheduled[studentId] = 0;
+    indexSchedule();
+    return {};
+}
+
+vector<string> InterviewScheduler::withdrawCompany(const string& companyName) {
+    int companyId = companyIds.find(companyName);
+    if (companyId == -1) {
+        return {"Unknown company " + companyName};
+    }
+    unschedule([companyId](const Placement& p) { return p.company == companyId; });
+
+    // Remaining interviews of affected students are left where they are
+    for (int studentId = 0; studentId < (int)students.size(); studentId++) {
+        if (priorityRank(studentId, companyId) != INT_MAX) {
+            priorityCount[studentId]--;
         }
+        vector<int>& shortlist = shortlists[studentId];
+        shortlist.erase(remove(shortlist.begin(), shortlist.end(), companyId), shortlist.end());
+        auto& names = students[studentId].shortlistedCompanies;
+        names.erase(remove(names.begin(), names.end(), companyName), names.end());
+        auto& priorities = students[studentId].priorities;
+        priorities.erase(remove(priorities.begin(), priorities.end(), companyName), priorities.end());
+    }
+    companies[companyId] = Company(companyName);
+    panelOccupancy[companyId].clear();
+    panelMatrix[companyId] = PanelMatrix();
+    panelStarts[companyId] = StartTable();
+    panelMinutes[companyId].clear();
+    panelDropped[companyId].clear();
+    companyWindows[companyId].clear();
+    panelWindows[companyId].clear();
+    indexSchedule();
+    return {};
+}
+
+vector<string> InterviewScheduler::dropPanel(const string& companyName, int panelId) {
+    int companyId = companyIds.find(companyName);
+    if (companyId == -1) {
+        return {"Unknown company " + companyName};
+    }
+    if (panelId < 0 || panelId >= companies[companyId].numPanels) {
+        return {"Unknown panel " + to_string(panelId + 1) + " for company " + companyName};
     }
 
+    // Every student with a round on the panel loses all rounds of this company,
+    // since later rounds are chained to earlier ones
+    vector<char> affected(students.size(), 0);
+    for (const auto& p : schedule) {
+        if (p.company == companyId && p.panelId == panelId) {
+            affected[p.student] = 1;
+        }
+    }
+    vector<Placement> removed = unschedule([&](const Placement& p) {
+        return p.company == companyId && affected[p.student];
+    });
+
+    panelDropped[companyId][panelId] = 1;
+    SlotBitmap& panel = panelOccupancy[companyId][panelId];
+    panelStarts[companyId].uncount(panel, 0, panel.size());
+    panel.reserve(0, panel.size());
+    panelStarts[companyId].count(panel, 0, panel.size());
+    panelMatrix[companyId].reserve(panelId, 0, panel.size());
+
+    // Re-place in the order the interviews were originally booked
+    vector<string> conflicts;
+    for (const auto& p : removed) {
+        if (p.round != 1) continue;
+        vector<Placement> placed;
+        if (!placeCompanyRounds(p.student, companyId, availableSlot.startTime, placed)) {
+            conflicts.push_back("Cannot schedule " + companyName + " for student " + studentIds.name(p.student));
+            dropIncompleteStudent(p.student, conflicts);
+            continue;
+        }
+        schedule.append(placed);
+    }
+    indexSchedule();
     return conflicts;
 }
 
-vector<Interview> InterviewScheduler::getSchedule() const {
-    return schedule;
+void InterviewScheduler::indexSchedule() {
+    schedule.buildIndexes(students.size(), companies.size());
+}
+
+ScheduleView InterviewScheduler::getSchedule() const {
+    return ScheduleView(schedule, studentIds, companyIds);
+}
+
+ScheduleView InterviewScheduler::getStudentSchedule(const string& rollNumber) const {
+    const ScheduleIndex& index = schedule.studentIndex();
+    int studentId = studentIds.find(rollNumber);
+    if (studentId == -1 || studentId >= (int)index.keyCount()) {
+        return ScheduleView(schedule, studentIds, companyIds, nullptr, nullptr);
+    }
+    return ScheduleView(schedule, studentIds, companyIds, index.begin(studentId), index.end(studentId));
+}
+
+ScheduleView InterviewScheduler::getCompanySchedule(const string& companyName) const {
+    const ScheduleIndex& index = schedule.companyIndex();
+    int companyId = companyIds.find(companyName);
+    if (companyId == -1 || companyId >= (int)index.keyCount()) {
+        return ScheduleView(schedule, studentIds, companyIds, nullptr, nullptr);
+    }
+    return ScheduleView(schedule, studentIds, companyIds, index.begin(companyId), index.end(companyId));
+}
+
+// Companies that were actually added; names only seen in shortlists are skipped
+vector<Company> InterviewScheduler::getCompanies() const {
+    vector<Company> result;
+    for (const auto& company : companies) {
+        if (company.numRounds > 0 || company.numPanels > 0 || company.durationPerRound > 0) {
+            result.push_back(company);
+        }
+    }
+    return result;
+}
+
+vector<Student> InterviewScheduler::getStudents() const {
+    return students;
+}
+
+int InterviewScheduler::getTimeSlotDuration() const {
+    return timeSlotDuration;
+}
+
+const vector<TimeSlot>& InterviewScheduler::getDays() const {
+    return dayWindows;
+}
+
+const vector<TimeSlot>& InterviewScheduler::getBreaks() const {
+    return breaks;
+}
+
+vector<TimeSlot> InterviewScheduler::getCompanyAvailability(const string& companyName) const {
+    int companyId = companyIds.find(companyName);
+    return companyId == -1 ? vector<TimeSlot>() : companyWindows[companyId];
+}
+
+vector<TimeSlot> InterviewScheduler::getPanelAvailability(const string& companyName, int panelId) const {
+    int companyId = companyIds.find(companyName);
+    if (companyId == -1 || panelId < 0 || panelId >= (int)panelWindows[companyId].size()) {
+        return {};
+    }
+    return panelWindows[companyId][panelId];
+}
+
+vector<int> InterviewScheduler::getDroppedPanels(const string& companyName) const {
+    int companyId = companyIds.find(companyName);
+    vector<int> result;
+    if (companyId == -1) {
+        return result;
+    }
+    for (int panelId = 0; panelId < (int)panelDropped[companyId].size(); panelId++) {
+        if (panelDropped[companyId][panelId]) {
+            result.push_back(panelId);
+        }
+    }
+    return result;
+}
+
+TimeSlot InterviewScheduler::getAvailableSlot() const {
+    return availableSlot;
+}
+
+// Students with at least one shortlisted company that is not fully booked
+vector<string> InterviewScheduler::getUnscheduledStudents() const {
+    vector<string> result;
+    for (int studentId = 0; studentId < (int)students.size(); studentId++) {
+        if (!studentScheduled[studentId] && !shortlists[studentId].empty()) {
+            result.push_back(studentIds.name(studentId));
+        }
+    }
+    return result;
+}
+
+const ScheduleStats& InterviewScheduler::getLastRunStats() const {
+    return lastRunStats;
+}
+
+uint64_t InterviewScheduler::getSeed() const {
+    return orderingSeed;
+}
+
+Objective InterviewScheduler::getObjective() const {
+    return objective;
+}
+
+SearchStrategy InterviewScheduler::getSearchStrategy() const {
+    return searchStrategy;
+}
+
+SolverBackend InterviewScheduler::getSolverBackend() const {
+    return solverBackend;
+}
+
+SchedulingMode InterviewScheduler::getSchedulingMode() const {
+    return schedulingMode;
+}
+
+StudentOrdering InterviewScheduler::getStudentOrdering() const {
+    return ordering;
+}
+
+int InterviewScheduler::getRequestedTimeSlotDuration() const {
+    return requestedSlotDuration;
+}
+
+int InterviewScheduler::getWorkerThreads() const {
+    return workerThreads;
+}
+
+long long InterviewScheduler::getNodeBudget() const {
+    return nodeBudget;
+}
+
+bool InterviewScheduler::getLocalSearch() const {
+    return localSearch;
+}
+
+bool InterviewScheduler::getSingleRoundMatching() const {
+    return singleRoundMatching;
+}
+
+CostModel InterviewScheduler::costModel() const {
+    CostModel model(objective);
+    for (const auto& p : schedule) {
+        model.add(p);
+    }
+    return model;
+}
+
+ScheduleMetrics InterviewScheduler::getScheduleMetrics() const {
+    CostModel model = costModel();
+    ScheduleMetrics metrics;
+    metrics.makespan = model.makespan();
+    metrics.idleMinutes = model.idleMinutes();
+    for (int companyId = 0; companyId < (int)companies.size(); companyId++) {
+        int most = -1;
+        int least = -1;
+        for (int panelId = 0; panelId < (int)panelMinutes[companyId].size(); panelId++) {
+            if (panelDropped[companyId][panelId]) continue;
+            int minutes = panelMinutes[companyId][panelId];
+            most = most == -1 ? minutes : max(most, minutes);
+            least = least == -1 ? minutes : min(least, minutes);
+        }
+        metrics.panelSpread += most - least;
+    }
+    return metrics;
+}
+
+// Everything is hashed in id order, which is the order it was added in and
+// therefore part of the input. Student names are left out; they never
+// affect the schedule.
+uint64_t InterviewScheduler::inputFingerprint() const {
+    Fingerprint f;
+    auto addWindows = [&f](const vector<TimeSlot>& windows) {
+        f.add((uint64_t)windows.size());
+        for (const auto& window : windows) {
+            f.add(window.startTime);
+            f.add(window.endTime);
+        }
+    };
+
+    f.add((int)searchStrategy);
+    f.add((int)ordering);
+    f.add(orderingSeed);
+    f.add(nodeBudget);
+    f.add(localSearch);
+    f.add((int)objective);
+    f.add((int)solverBackend);
+    f.add(singleRoundMatching);
+    f.add((int)schedulingMode);
+    f.add(studentAttemptLimit);
+    f.add(requestedSlotDuration);
+
+    addWindows(dayWindows);
+    addWindows(breaks);
+
+    f.add((uint64_t)companies.size());
+    for (int companyId = 0; companyId < (int)companies.size(); companyId++) {
+        const Company& company = companies[companyId];
+        f.add(company.name);
+        f.add(company.durationPerRound);
+        f.add(company.numRounds);
+        f.add(company.numPanels);
+        addWindows(companyWindows[companyId]);
+        f.add((uint64_t)panelWindows[companyId].size());
+        for (int panelId = 0; panelId < (int)panelWindows[companyId].size(); panelId++) {
+            addWindows(panelWindows[companyId][panelId]);
+            f.add(panelDropped[companyId][panelId] != 0);
+        }
+    }
+
+    f.add((uint64_t)students.size());
+    for (const auto& student : students) {
+        f.add(student.rollNumber);
+        f.add((uint64_t)student.shortlistedCompanies.size());
+        for (const auto& companyName : student.shortlistedCompanies) {
+            f.add(companyName);
+        }
+        f.add((uint64_t)student.priorities.size());
+        for (const auto& companyName : student.priorities) {
+            f.add(companyName);
+        }
+        addWindows(student.unavailable);
+    }
+    return f.value();
+}
+
+// Rows in schedule order, with names rather than ids
+uint64_t InterviewScheduler::scheduleHash() const {
+    Fingerprint f;
+    f.add((uint64_t)schedule.size());
+    for (size_t i = 0; i < schedule.size(); i++) {
+        f.add(studentIds.name(schedule.student(i)));
+        f.add(companyIds.name(schedule.company(i)));
+        f.add(schedule.round(i));
+        f.add(schedule.timeSlot(i).startTime);
+        f.add(schedule.timeSlot(i).endTime);
+        f.add(schedule.panelId(i));
+    }
+    return f.value();
 }
 
 string InterviewScheduler::timeToString(int minutes) {
+    // Multi-day schedules name the day, counted from 1
+    string day;
+    if (availableSlot.endTime > MINUTES_PER_DAY) {
+        day = "Day " + to_string(minutes / MINUTES_PER_DAY + 1) + " ";
+        minutes %= MINUTES_PER_DAY;
+    }
     int hours = minutes / 60;
     int mins = minutes % 60;
     string period = (hours < 12) ? "AM" : "PM";
@@ -195,7 +1777,7 @@ string InterviewScheduler::timeToString(int minutes) {
     
     char buffer[10];
     snprintf(buffer, sizeof(buffer), "%d:%02d %s", hours, mins, period.c_str());
-    return std::string(buffer);
+    return day + std::string(buffer);
 }
 
 void InterviewScheduler::printStudentSchedule(const string& studentId) {
@@ -205,19 +1787,8 @@ void InterviewScheduler::printStudentSchedule(const string& studentId) {
          << setw(12) << "Start" << setw(12) << "End" << setw(8) << "Panel\n";
     cout << string(50, '-') << "\n";
 
-    vector<Interview> studentInterviews;
-    for (const auto& i : schedule) {
-        if (i.studentId == studentId) {
-            studentInterviews.push_back(i);
-        }
-    }
-
-    sort(studentInterviews.begin(), studentInterviews.end(),
-         [](const Interview& a, const Interview& b) { 
-             return a.timeSlot.startTime < b.timeSlot.startTime; 
-         });
-
-    for (const auto& i : studentInterviews) {
+    // The student index already holds the rows in start-time order
+    for (const auto& i : getStudentSchedule(studentId)) {
         cout << setw(12) << i.companyName
              << setw(8) << i.round
              << setw(12) << timeToString(i.timeSlot.startTime)
@@ -227,16 +1798,18 @@ void InterviewScheduler::printStudentSchedule(const string& studentId) {
 }
 
 void InterviewScheduler::printCompleteSchedule() {
-    map<string, vector<Interview>> studentGroups;
-    for (const auto& i : schedule) {
-        studentGroups[i.studentId].push_back(i);
+    const ScheduleIndex& index = schedule.studentIndex();
+    vector<int> booked;
+    for (int studentId = 0; studentId < (int)index.keyCount(); studentId++) {
+        if (index.begin(studentId) != index.end(studentId)) {
+            booked.push_back(studentId);
+        }
     }
+    sort(booked.begin(), booked.end(), [this](int a, int b) {
+        return studentIds.name(a) < studentIds.name(b);
+    });
 
-    for (auto& p : studentGroups) {
-        sort(p.second.begin(), p.second.end(),
-             [](const Interview& a, const Interview& b) { 
-                 return a.timeSlot.startTime < b.timeSlot.startTime; 
-             });
-        printStudentSchedule(p.first);
+    for (int studentId : booked) {
+        printStudentSchedule(studentIds.name(studentId));
     }
 }
@@ -0,0 +1,577 @@
+#include "core/InterviewScheduler.h"
+#include "core/Parallel.h"
+
+#include <map>
+
+using namespace std;
+
+// Improvement pass run after greedy construction. Works one shortlist
+// component at a time, so components can be improved on separate threads:
+//   1. repair   - place students the greedy pass gave up on, ejecting a
+//                 chain of up to ejectionDepth blocking interviews to other
+//                 slots when needed
+//   2. compact  - move interviews to earlier free slots (makespan)
+//   3. swap     - exchange two students' slots in the same company round
+//                 when it shortens their combined time on campus
+//   4. retime   - with an objective set, move single interviews next to the
+//                 student's other interviews or onto another panel
+//   5. pull     - with the makespan objective, move the interviews that end
+//                 last to an earlier start by ejecting what blocks them there
+// Every move is checked against the occupancy bitmaps and undone if it does
+// not pay off, so the schedule stays valid throughout. With an objective,
+// "pays off" means it lowers the CostModel's cost instead of the fixed
+// rules of compact and swap.
+
+// Start of the round before / after `round` of the same company for a
+// student; a round must fit between the two
+int InterviewScheduler::roundLowerBound(const vector<Placement>& placements, int companyId, int round) const {
+    for (const auto& p : placements) {
+        if (p.company == companyId && p.round == round - 1) {
+            return p.timeSlot.endTime;
+        }
+    }
+    return availableSlot.startTime;
+}
+
+int InterviewScheduler::roundUpperBound(const vector<Placement>& placements, int companyId, int round) const {
+    for (const auto& p : placements) {
+        if (p.company == companyId && p.round == round + 1) {
+            return p.timeSlot.startTime;
+        }
+    }
+    return availableSlot.endTime;
+}
+
+// Minutes between a student's first interview start and last interview end
+int InterviewScheduler::studentSpan(const vector<Placement>& placements) const {
+    if (placements.empty()) {
+        return 0;
+    }
+    int first = placements[0].timeSlot.startTime;
+    int last = placements[0].timeSlot.endTime;
+    for (const auto& p : placements) {
+        first = min(first, p.timeSlot.startTime);
+        last = max(last, p.timeSlot.endTime);
+    }
+    return last - first;
+}
+
+// Tries to give `studentId` a round of companyId starting in
+// [fromTime, untilTime) by ejecting the one interview that blocks a panel
+// there. The ejected interview must stay between its neighbouring rounds;
+// if no free start is left for it, it ejects another interview in turn, up
+// to `depth` interviews deep. Students in `chain` were displaced earlier on
+// the same chain and are never ejected again. On success the slot is booked
+// for the student, panelId is set and every moved interview is recorded in
+// undo; the caller records the new interview itself. Returns the start time,
+// or -1 with everything restored.
+int InterviewScheduler::ejectForRound(int studentId, int companyId, int fromTime, int untilTime, int depth,
+                                      vector<int>& chain, const vector<int>& component,
+                                      vector<vector<Placement>>& placed, vector<Move>& undo, int& panelId) {
+    const Company& company = companies[companyId];
+    vector<pair<int, int>> candidates = companyPlacements(component, placed, companyId);
+    chain.push_back(studentId);
+
+    for (int startTime = findStudentGap(studentId, fromTime, company.durationPerRound);
+         startTime != -1 && startTime + company.durationPerRound <= untilTime;
+         startTime = findStudentGap(studentId, startTime + timeSlotDuration, company.durationPerRound)) {
+        TimeSlot wanted(startTime, startTime + company.durationPerRound);
+
+        for (panelId = 0; panelId < company.numPanels; panelId++) {
+            int blocker = -1;
+            int blockerIndex = -1;
+            int count = 0;
+            for (const auto& entry : candidates) {
+                const Placement& p = placed[entry.first][entry.second];
+                if (p.panelId == panelId && p.timeSlot.overlaps(wanted) &&
+                    find(chain.begin(), chain.end(), entry.first) == chain.end()) {
+                    blocker = entry.first;
+                    blockerIndex = entry.second;
+                    count++;
+                }
+            }
+            if (count != 1) continue;
+            if (!consumeNode()) {
+                chain.pop_back();
+                return -1;
+            }
+
+            Placement& victim = placed[blocker][blockerIndex];
+            Placement original = victim;
+            releasePanel(companyId, panelId, original.timeSlot);
+            releaseStudent(blocker, original.timeSlot);
+
+            if (!isPanelAvailable(companyId, panelId, wanted)) {
+                reservePanel(companyId, panelId, original.timeSlot);
+                reserveStudent(blocker, original.timeSlot);
+                continue;
+            }
+            reservePanel(companyId, panelId, wanted);
+            reserveStudent(studentId, wanted);
+
+            int lower = roundLowerBound(placed[blocker], companyId, original.round);
+            int upper = roundUpperBound(placed[blocker], companyId, original.round);
+            int newPanel = -1;
+            int newStart = findEarliestStart(blocker, companyId, lower, newPanel);
+            if (newStart != -1 && newStart + company.durationPerRound <= upper) {
+                reservePanel(companyId, newPanel, TimeSlot(newStart, newStart + company.durationPerRound));
+                reserveStudent(blocker, TimeSlot(newStart, newStart + company.durationPerRound));
+            } else if (depth > 1) {
+                newStart = ejectForRound(blocker, companyId, lower, upper, depth - 1, chain, component, placed, undo, newPanel);
+            } else {
+                newStart = -1;
+            }
+            if (newStart != -1) {
+                victim.timeSlot = TimeSlot(newStart, newStart + company.durationPerRound);
+                victim.panelId = newPanel;
+                undo.push_back({blocker, blockerIndex, original});
+                chain.pop_back();
+                return startTime;
+            }
+
+            releasePanel(companyId, panelId, wanted);
+            releaseStudent(studentId, wanted);
+            reservePanel(companyId, panelId, original.timeSlot);
+            reserveStudent(blocker, original.timeSlot);
+        }
+    }
+    chain.pop_back();
+    return -1;
+}
+
+// Puts moved interviews back. Along an ejection chain each interview moved
+// into a slot another one left, so every slot is released before any
+// original one is reserved again. An interview moved more than once goes
+// back to its first recorded slot.
+void InterviewScheduler::undoMoves(vector<vector<Placement>>& placed, const vector<Move>& undo) {
+    vector<pair<int, int>> moved;
+    for (const Move& move : undo) {
+        moved.push_back({move.student, move.index});
+    }
+    sort(moved.begin(), moved.end());
+    moved.erase(unique(moved.begin(), moved.end()), moved.end());
+
+    for (const auto& [studentId, index] : moved) {
+        const Placement& current = placed[studentId][index];
+        releasePanel(current.company, current.panelId, current.timeSlot);
+        releaseStudent(studentId, current.timeSlot);
+    }
+    for (auto it = undo.rbegin(); it != undo.rend(); ++it) {
+        placed[it->student][it->index] = it->previous;
+    }
+    for (const auto& [studentId, index] : moved) {
+        const Placement& original = placed[studentId][index];
+        reservePanel(original.company, original.panelId, original.timeSlot);
+        reserveStudent(studentId, original.timeSlot);
+    }
+}
+
+// (student, index) pairs of the component's interviews with one company
+vector<pair<int, int>> InterviewScheduler::companyPlacements(const vector<int>& component,
+                                                             const vector<vector<Placement>>& placed, int companyId) const {
+    vector<pair<int, int>> result;
+    for (int studentId : component) {
+        for (int i = 0; i < (int)placed[studentId].size(); i++) {
+            if (placed[studentId][i].company == companyId) {
+                result.push_back({studentId, i});
+            }
+        }
+    }
+    return result;
+}
+
+// Books every shortlisted company the student is still missing, ejecting
+// blockers where needed. All-or-nothing: on failure every change is undone.
+bool InterviewScheduler::repairStudent(int studentId, const vector<int>& component, vector<vector<Placement>>& placed) {
+    vector<Move> undo;
+    size_t existing = placed[studentId].size();
+    vector<char> booked(companies.size(), 0);
+    for (const auto& p : placed[studentId]) {
+        booked[p.company] = 1;
+    }
+
+    bool ok = true;
+    for (int companyId : shortlists[studentId]) {
+        if (booked[companyId]) continue;
+        booked[companyId] = 1;
+        const Company& company = companies[companyId];
+        int currentTime = availableSlot.startTime;
+
+        for (int round = 1; round <= company.numRounds && ok; round++) {
+            int panelId = -1;
+            int startTime = consumeNode() ? findEarliestStart(studentId, companyId, currentTime, panelId) : -1;
+            if (startTime != -1) {
+                TimeSlot slot(startTime, startTime + company.durationPerRound);
+                reservePanel(companyId, panelId, slot);
+                reserveStudent(studentId, slot);
+                placed[studentId].push_back({studentId, companyId, round, slot, panelId});
+            } else {
+                vector<int> chain;
+                startTime = ejectForRound(studentId, companyId, currentTime, availableSlot.endTime, ejectionDepth,
+                                          chain, component, placed, undo, panelId);
+                ok = startTime != -1;
+                if (ok) {
+                    placed[studentId].push_back({studentId, companyId, round,
+                                                 TimeSlot(startTime, startTime + company.durationPerRound), panelId});
+                }
+            }
+            currentTime = startTime + company.durationPerRound;
+        }
+        if (!ok) break;
+    }
+    if (ok) {
+        return true;
+    }
+
+    vector<Placement> added(placed[studentId].begin() + existing, placed[studentId].end());
+    releasePlacements(added);
+    placed[studentId].resize(existing);
+    undoMoves(placed, undo);
+    return false;
+}
+
+// Moves interviews to the earliest slot that fits between their rounds.
+// A move is kept if it ends the student's day earlier or does not lengthen it,
+// or with a model, if it lowers the cost.
+bool InterviewScheduler::compactComponent(const vector<int>& component, vector<vector<Placement>>& placed, CostModel* model) {
+    vector<pair<int, int>> order;
+    for (int studentId : component) {
+        for (int i = 0; i < (int)placed[studentId].size(); i++) {
+            order.push_back({studentId, i});
+        }
+    }
+    sort(order.begin(), order.end(), [&placed](const pair<int, int>& a, const pair<int, int>& b) {
+        const Placement& pa = placed[a.first][a.second];
+        const Placement& pb = placed[b.first][b.second];
+        if (pa.timeSlot.startTime != pb.timeSlot.startTime) {
+            return pa.timeSlot.startTime < pb.timeSlot.startTime;
+        }
+        return a < b;
+    });
+
+    bool improved = false;
+    for (const auto& entry : order) {
+        if (!consumeNode()) break;
+        vector<Placement>& mine = placed[entry.first];
+        Placement& p = mine[entry.second];
+        Placement original = p;
+        int spanBefore = studentSpan(mine);
+        int lastEnd = 0;
+        for (const auto& other : mine) {
+            lastEnd = max(lastEnd, other.timeSlot.endTime);
+        }
+
+        releasePanel(p.company, p.panelId, p.timeSlot);
+        releaseStudent(p.student, p.timeSlot);
+        int panelId = -1;
+        int startTime = findEarliestStart(p.student, p.company, roundLowerBound(mine, p.company, p.round), panelId);
+
+        bool keep = false;
+        if (startTime != -1 && startTime < original.timeSlot.startTime) {
+            p.timeSlot = TimeSlot(startTime, startTime + companies[p.company].durationPerRound);
+            p.panelId = panelId;
+            if (model) {
+                ScheduleCost before = model->cost();
+                model->remove(original);
+                model->add(p);
+                keep = model->cost() < before;
+                if (!keep) {
+                    model->remove(p);
+                    model->add(original);
+                }
+            } else {
+                keep = original.timeSlot.endTime == lastEnd || studentSpan(mine) <= spanBefore;
+            }
+        }
+        if (!keep) {
+            p = original;
+        }
+        reservePanel(p.company, p.panelId, p.timeSlot);
+        reserveStudent(p.student, p.timeSlot);
+        improved |= keep;
+    }
+    return improved;
+}
+
+// Exchanges the students of two interviews in the same company round when
+// both still fit their calendars and round order and their combined span
+// shrinks, or with a model, the cost drops or stays level while the span
+// shrinks. Panel occupancy is unchanged by a swap.
+bool InterviewScheduler::swapComponent(const vector<int>& component, vector<vector<Placement>>& placed, CostModel* model) {
+    const int window = 32; // neighbours considered per interview
+
+    map<pair<int, int>, vector<pair<int, int>>> groups; // (company, round) -> placements
+    for (int studentId : component) {
+        for (int i = 0; i < (int)placed[studentId].size(); i++) {
+            const Placement& p = placed[studentId][i];
+            groups[{p.company, p.round}].push_back({studentId, i});
+        }
+    }
+
+    bool improved = false;
+    for (auto& group : groups) {
+        auto& members = group.second;
+        sort(members.begin(), members.end(), [&placed](const pair<int, int>& a, const pair<int, int>& b) {
+            return placed[a.first][a.second].timeSlot.startTime < placed[b.first][b.second].timeSlot.startTime;
+        });
+
+        for (size_t x = 0; x < members.size(); x++) {
+            for (size_t y = x + 1; y < members.size() && y <= x + window; y++) {
+                int a = members[x].first;
+                int b = members[y].first;
+                if (a == b) continue;
+                if (!consumeNode()) return improved;
+
+                Placement& pa = placed[a][members[x].second];
+                Placement& pb = placed[b][members[y].second];
+                TimeSlot slotA = pa.timeSlot;
+                TimeSlot slotB = pb.timeSlot;
+                int before = studentSpan(placed[a]) + studentSpan(placed[b]);
+
+                if (slotB.startTime < roundLowerBound(placed[a], pa.company, pa.round) ||
+                    slotB.endTime > roundUpperBound(placed[a], pa.company, pa.round) ||
+                    slotA.startTime < roundLowerBound(placed[b], pb.company, pb.round) ||
+                    slotA.endTime > roundUpperBound(placed[b], pb.company, pb.round)) {
+                    continue;
+                }
+
+                releaseStudent(a, slotA);
+                releaseStudent(b, slotB);
+                bool fits = isStudentAvailable(a, slotB) && isStudentAvailable(b, slotA);
+                if (fits) {
+                    Placement oldA = pa;
+                    Placement oldB = pb;
+                    swap(pa.timeSlot, pb.timeSlot);
+                    swap(pa.panelId, pb.panelId);
+                    bool better;
+                    if (model) {
+                        ScheduleCost costBefore = model->cost();
+                        model->remove(oldA);
+                        model->remove(oldB);
+                        model->add(pa);
+                        model->add(pb);
+                        ScheduleCost costAfter = model->cost();
+                        better = costAfter < costBefore ||
+                                 (!(costBefore < costAfter) && studentSpan(placed[a]) + studentSpan(placed[b]) < before);
+                        if (!better) {
+                            model->remove(pa);
+                            model->remove(pb);
+                            model->add(oldA);
+                            model->add(oldB);
+                        }
+                    } else {
+                        better = studentSpan(placed[a]) + studentSpan(placed[b]) < before;
+                    }
+                    if (better) {
+                        reserveStudent(a, pa.timeSlot);
+                        reserveStudent(b, pb.timeSlot);
+                        improved = true;
+                        continue;
+                    }
+                    swap(pa.timeSlot, pb.timeSlot);
+                    swap(pa.panelId, pb.panelId);
+                }
+                reserveStudent(a, slotA);
+                reserveStudent(b, slotB);
+            }
+        }
+    }
+    return improved;
+}
+
+// Moves one interview at a time to the candidate start that lowers the cost
+// most: right after or right before another interview of the same student,
+// the earliest start its round allows, or its current start on another
+// panel. Balancing panels takes the least-booked free one, otherwise the
+// lowest.
+bool InterviewScheduler::retimeComponent(const vector<int>& component, vector<vector<Placement>>& placed, CostModel& model) {
+    bool improved = false;
+    for (int studentId : component) {
+        vector<Placement>& mine = placed[studentId];
+        for (int i = 0; i < (int)mine.size(); i++) {
+            if (!consumeNode()) return improved;
+            Placement& p = mine[i];
+            Placement original = p;
+            int duration = companies[p.company].durationPerRound;
+            int lower = max(roundLowerBound(mine, p.company, p.round), availableSlot.startTime);
+            int upper = min(roundUpperBound(mine, p.company, p.round), availableSlot.endTime);
+
+            vector<int> starts = {original.timeSlot.startTime};
+            for (int j = 0; j < (int)mine.size(); j++) {
+                if (j == i) continue;
+                starts.push_back(mine[j].timeSlot.endTime);
+                starts.push_back(mine[j].timeSlot.startTime - duration);
+            }
+
+            releasePanel(p.company, p.panelId, p.timeSlot);
+            releaseStudent(studentId, p.timeSlot);
+            int panelId = -1;
+            int earliest = findEarliestStart(studentId, p.company, lower, panelId);
+            if (earliest != -1) {
+                starts.push_back(earliest);
+            }
+
+            ScheduleCost best = model.cost();
+            Placement chosen = original;
+            model.remove(original);
+            for (int startTime : starts) {
+                TimeSlot slot(startTime, startTime + duration);
+                if (startTime < lower || slot.endTime > upper ||
+                    (startTime - availableSlot.startTime) % timeSlotDuration != 0 ||
+                    !isStudentAvailable(studentId, slot)) {
+                    continue;
+                }
+                int startSlot, endSlot;
+                slotRange(slot, startSlot, endSlot);
+                p.panelId = objective == Objective::PanelBalance ? leastBookedPanel(p.company, startSlot, endSlot)
+                                                                 : choosePanel(p.company, startSlot, endSlot);
+                if (p.panelId == -1) continue;
+                p.timeSlot = slot;
+                model.add(p);
+                ScheduleCost cost = model.cost();
+                model.remove(p);
+                if (cost < best) {
+                    best = cost;
+                    chosen = p;
+                }
+            }
+
+            p = chosen;
+            model.add(p);
+            reservePanel(p.company, p.panelId, p.timeSlot);
+            reserveStudent(studentId, p.timeSlot);
+            improved |= p.timeSlot.startTime != original.timeSlot.startTime || p.panelId != original.panelId;
+        }
+    }
+    return improved;
+}
+
+// Single moves cannot lower the makespan: every interview already sits at
+// its earliest free start. Each interview ending at the makespan is instead
+// re-placed strictly earlier by ejecting the chain of interviews blocking a
+// panel there (ejectForRound). The whole chain is kept only if the cost
+// drops, which counts an interview leaving the makespan even while others
+// still end there.
+bool InterviewScheduler::pullLastInterviews(const vector<int>& component, vector<vector<Placement>>& placed, CostModel& model) {
+    vector<pair<int, int>> last;
+    for (int studentId : component) {
+        for (int i = 0; i < (int)placed[studentId].size(); i++) {
+            if (placed[studentId][i].timeSlot.endTime == model.makespan()) {
+                last.push_back({studentId, i});
+            }
+        }
+    }
+
+    bool improved = false;
+    for (const auto& [studentId, index] : last) {
+        if (!consumeNode()) break;
+        Placement& p = placed[studentId][index];
+        Placement original = p;
+        int duration = companies[p.company].durationPerRound;
+        int lower = roundLowerBound(placed[studentId], p.company, p.round);
+        int upper = min(roundUpperBound(placed[studentId], p.company, p.round),
+                        original.timeSlot.endTime - timeSlotDuration);
+
+        releasePanel(p.company, p.panelId, p.timeSlot);
+        releaseStudent(studentId, p.timeSlot);
+        vector<Move> undo;
+        vector<int> chain;
+        int panelId = -1;
+        int startTime = ejectForRound(studentId, p.company, lower, upper, ejectionDepth, chain, component, placed, undo, panelId);
+        if (startTime == -1) {
+            reservePanel(p.company, p.panelId, p.timeSlot);
+            reserveStudent(studentId, p.timeSlot);
+            continue;
+        }
+
+        ScheduleCost before = model.cost();
+        p.timeSlot = TimeSlot(startTime, startTime + duration);
+        p.panelId = panelId;
+        model.remove(original);
+        model.add(p);
+        for (const Move& move : undo) {
+            model.remove(move.previous);
+            model.add(placed[move.student][move.index]);
+        }
+        if (model.cost() < before) {
+            improved = true;
+            continue;
+        }
+
+        model.remove(p);
+        model.add(original);
+        for (const Move& move : undo) {
+            model.remove(placed[move.student][move.index]);
+            model.add(move.previous);
+        }
+        releasePanel(p.company, p.panelId, p.timeSlot);
+        releaseStudent(studentId, p.timeSlot);
+        undoMoves(placed, undo);
+        p = original;
+        reservePanel(p.company, p.panelId, p.timeSlot);
+        reserveStudent(studentId, p.timeSlot);
+    }
+    return improved;
+}
+
+void InterviewScheduler::improveComponent(const vector<int>& component, vector<vector<Placement>>& placed,
+                                          vector<char>& scheduled, bool repair) {
+    const int maxPasses = 3;
+
+    if (repair) {
+        for (int studentId : component) {
+            if (!scheduled[studentId] && !shortlists[studentId].empty()) {
+                scheduled[studentId] = repairStudent(studentId, component, placed);
+            }
+        }
+    }
+
+    // Without an objective the passes follow their fixed acceptance rules
+    CostModel model(objective);
+    CostModel* costs = nullptr;
+    if (objective != Objective::Feasible) {
+        costs = &model;
+        for (int studentId : component) {
+            for (const auto& p : placed[studentId]) {
+                model.add(p);
+            }
+        }
+    }
+    for (int pass = 0; pass < maxPasses; pass++) {
+        bool improved = compactComponent(component, placed, costs);
+        improved |= swapComponent(component, placed, costs);
+        if (costs) {
+            improved |= retimeComponent(component, placed, model);
+        }
+        if (objective == Objective::Makespan) {
+            improved |= pullLastInterviews(component, placed, model);
+        }
+        if (!improved) break;
+    }
+}
+
+// Runs the improvement pass on the current schedule, e.g. after a series of
+// incremental edits. Returns the students that are still not fully placed.
+vector<string> InterviewScheduler::improveSchedule() {
+    vector<int> order = orderStudents();
+    vector<vector<int>> components = partitionComponents(order);
+    vector<vector<Placement>> placed(students.size());
+    for (const auto& p : schedule) {
+        placed[p.student].push_back(p);
+    }
+
+    parallelFor((int)components.size(), workerThreads, [&](int c) {
+        improveComponent(components[c], placed, studentScheduled, true);
+    });
+
+    schedule.clear();
+    vector<string> conflicts;
+    for (int studentId : order) {
+        schedule.append(placed[studentId]);
+        if (!studentScheduled[studentId] && !shortlists[studentId].empty()) {
+            conflicts.push_back("Cannot schedule all interviews for student " + studentIds.name(studentId));
+        }
+    }
+    indexSchedule();
+    return conflicts;
+}
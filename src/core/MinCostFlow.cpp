@@ -0,0 +1,71 @@
+#include "core/MinCostFlow.h"
+
+#include <algorithm>
+#include <climits>
+#include <queue>
+
+using namespace std;
+
+MinCostFlow::MinCostFlow(int nodes) : adjacency(nodes) {}
+
+int MinCostFlow::addEdge(int from, int to, int capacity, long long cost) {
+    int index = (int)edges.size();
+    edges.push_back({to, capacity, cost});
+    adjacency[from].push_back(index);
+    edges.push_back({from, 0, -cost});
+    adjacency[to].push_back(index + 1);
+    return index;
+}
+
+int MinCostFlow::solve(int source, int sink, const function<bool()>& consumeNode) {
+    const long long INF = LLONG_MAX / 4;
+    int nodes = (int)adjacency.size();
+    vector<long long> potential(nodes, 0);
+    vector<long long> dist(nodes);
+    vector<int> parentEdge(nodes);
+    int totalFlow = 0;
+
+    while (consumeNode()) {
+        fill(dist.begin(), dist.end(), INF);
+        fill(parentEdge.begin(), parentEdge.end(), -1);
+        dist[source] = 0;
+
+        using Entry = pair<long long, int>;
+        priority_queue<Entry, vector<Entry>, greater<Entry>> queue;
+        queue.push({0, source});
+        while (!queue.empty()) {
+            auto [d, node] = queue.top();
+            queue.pop();
+            if (d > dist[node]) continue;
+            for (int e : adjacency[node]) {
+                const Edge& edge = edges[e];
+                if (edge.capacity <= 0) continue;
+                long long next = d + edge.cost + potential[node] - potential[edge.to];
+                if (next < dist[edge.to]) {
+                    dist[edge.to] = next;
+                    parentEdge[edge.to] = e;
+                    queue.push({next, edge.to});
+                }
+            }
+        }
+        if (dist[sink] == INF) {
+            break;
+        }
+        for (int node = 0; node < nodes; node++) {
+            if (dist[node] < INF) {
+                potential[node] += dist[node];
+            }
+        }
+
+        int push = INT_MAX;
+        for (int node = sink; node != source; node = edges[parentEdge[node] ^ 1].to) {
+            push = min(push, edges[parentEdge[node]].capacity);
+        }
+        for (int node = sink; node != source; node = edges[parentEdge[node] ^ 1].to) {
+            edges[parentEdge[node]].capacity -= push;
+            edges[parentEdge[node] ^ 1].capacity += push;
+        }
+        totalFlow += push;
+    }
+    return totalFlow;
+}
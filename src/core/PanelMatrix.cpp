@@ -0,0 +1,119 @@
+#include "core/PanelMatrix.h"
+
+#include <algorithm>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+PanelMatrix::PanelMatrix(const vector<SlotBitmap>& panels)
+    : numPanels((int)panels.size()), numSlots(panels.empty() ? 0 : panels[0].size()),
+      stride(((int)panels.size() + 63) / 64) {
+    cells.assign((size_t)numSlots * stride, 0);
+    for (int p = 0; p < numPanels; p++) {
+        uint64_t bit = uint64_t(1) << (p & 63);
+        for (int slot = panels[p].nextBusy(0); slot < numSlots; ) {
+            int end = panels[p].nextFree(slot);
+            for (int s = slot; s < end; s++) {
+                cells[(size_t)s * stride + (p >> 6)] |= bit;
+            }
+            slot = panels[p].nextBusy(end);
+        }
+    }
+}
+
+uint64_t PanelMatrix::panelMask(int word) const {
+    int bits = numPanels - word * 64;
+    return bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+}
+
+void PanelMatrix::reserve(int panel, int begin, int end) {
+    begin = max(begin, 0);
+    end = min(end, numSlots);
+    uint64_t bit = uint64_t(1) << (panel & 63);
+    for (int s = begin; s < end; s++) {
+        cells[(size_t)s * stride + (panel >> 6)] |= bit;
+    }
+}
+
+void PanelMatrix::release(int panel, int begin, int end) {
+    begin = max(begin, 0);
+    end = min(end, numSlots);
+    uint64_t bit = uint64_t(1) << (panel & 63);
+    for (int s = begin; s < end; s++) {
+        cells[(size_t)s * stride + (panel >> 6)] &= ~bit;
+    }
+}
+
+void PanelMatrix::orRows(int begin, int end, int word, uint64_t acc[2]) const {
+    acc[0] = acc[1] = 0;
+    if (begin >= end) {
+        return;
+    }
+    const uint64_t* row = cells.data() + (size_t)begin * stride + word;
+    int s = begin;
+#ifdef __SSE2__
+    __m128i sum = _mm_setzero_si128();
+    if (stride == 1) {
+        // Rows are single words, so one load covers two slots
+        for (; s + 2 <= end; s += 2, row += 2) {
+            sum = _mm_or_si128(sum, _mm_loadu_si128((const __m128i*)row));
+        }
+        sum = _mm_or_si128(sum, _mm_unpackhi_epi64(sum, sum));
+    } else if (word + 2 <= stride) {
+        for (; s < end; s++, row += stride) {
+            sum = _mm_or_si128(sum, _mm_loadu_si128((const __m128i*)row));
+        }
+    }
+    _mm_storeu_si128((__m128i*)acc, sum);
+    if (stride == 1) {
+        acc[1] = 0;
+    }
+#endif
+    for (; s < end; s++, row += stride) {
+        acc[0] |= row[0];
+        if (word + 1 < stride) {
+            acc[1] |= row[1];
+        }
+    }
+}
+
+void PanelMatrix::freePanels(int begin, int end, vector<uint64_t>& free) const {
+    free.assign(stride, 0);
+    if (begin < end && (begin < 0 || end > numSlots)) {
+        return;
+    }
+    for (int w = 0; w < stride; w += 2) {
+        uint64_t acc[2];
+        orRows(begin, end, w, acc);
+        free[w] = ~acc[0] & panelMask(w);
+        if (w + 1 < stride) {
+            free[w + 1] = ~acc[1] & panelMask(w + 1);
+        }
+    }
+}
+
+int PanelMatrix::firstFreePanel(int begin, int end) const {
+    if (begin >= end) {
+        return numPanels > 0 ? 0 : -1;
+    }
+    if (begin < 0 || end > numSlots) {
+        return -1;
+    }
+    for (int w = 0; w < stride; w += 2) {
+        uint64_t acc[2];
+        orRows(begin, end, w, acc);
+        uint64_t free = ~acc[0] & panelMask(w);
+        if (free) {
+            return w * 64 + __builtin_ctzll(free);
+        }
+        if (w + 1 < stride) {
+            free = ~acc[1] & panelMask(w + 1);
+            if (free) {
+                return (w + 1) * 64 + __builtin_ctzll(free);
+            }
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,86 @@
+#include "core/ScheduleStore.h"
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+using namespace std;
+
+void ScheduleIndex::build(const vector<int32_t>& keys, size_t keyCount, const vector<int32_t>& order) {
+    offsets.assign(keyCount + 1, 0);
+    for (int32_t key : keys) {
+        if (key >= 0 && (size_t)key < keyCount) {
+            offsets[key + 1]++;
+        }
+    }
+    for (size_t k = 0; k < keyCount; k++) {
+        offsets[k + 1] += offsets[k];
+    }
+
+    // Scattering rows in start-time order keeps every group sorted
+    rows.resize(offsets[keyCount]);
+    vector<int32_t> next(offsets.begin(), offsets.end() - 1);
+    for (int32_t row : order) {
+        int32_t key = keys[row];
+        if (key >= 0 && (size_t)key < keyCount) {
+            rows[next[key]++] = row;
+        }
+    }
+}
+
+void ScheduleIndex::clear() {
+    offsets.clear();
+    rows.clear();
+}
+
+void ScheduleStore::clear() {
+    students.clear();
+    companies.clear();
+    startTimes.clear();
+    endTimes.clear();
+    rounds.clear();
+    panels.clear();
+    byStudent.clear();
+    byCompany.clear();
+}
+
+void ScheduleStore::reserve(size_t count) {
+    students.reserve(count);
+    companies.reserve(count);
+    startTimes.reserve(count);
+    endTimes.reserve(count);
+    rounds.reserve(count);
+    panels.reserve(count);
+}
+
+void ScheduleStore::push_back(const Placement& placement) {
+    assert(placement.round >= 0 && placement.round <= maxColumnValue);
+    assert(placement.panelId >= 0 && placement.panelId <= maxColumnValue);
+    students.push_back(placement.student);
+    companies.push_back(placement.company);
+    startTimes.push_back(placement.timeSlot.startTime);
+    endTimes.push_back(placement.timeSlot.endTime);
+    rounds.push_back((int16_t)placement.round);
+    panels.push_back((int16_t)placement.panelId);
+    byStudent.clear();
+    byCompany.clear();
+}
+
+void ScheduleStore::append(const vector<Placement>& placements) {
+    for (const auto& placement : placements) {
+        push_back(placement);
+    }
+}
+
+Placement ScheduleStore::operator[](size_t i) const {
+    return {students[i], companies[i], rounds[i], TimeSlot(startTimes[i], endTimes[i]), panels[i]};
+}
+
+void ScheduleStore::buildIndexes(size_t studentCount, size_t companyCount) {
+    vector<int32_t> order(size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [this](int32_t a, int32_t b) {
+        return startTimes[a] < startTimes[b];
+    });
+    byStudent.build(students, studentCount, order);
+    byCompany.build(companies, companyCount, order);
+}
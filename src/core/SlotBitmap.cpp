@@ -0,0 +1,152 @@
+#include "core/SlotBitmap.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// An empty or inverted range gives a bitmap with no slots
+SlotBitmap::SlotBitmap(int slots) : words((max(slots, 0) + 63) / 64, 0), numSlots(max(slots, 0)) {
+    // Padding bits past the last slot stay permanently taken
+    if (!words.empty() && numSlots % 64 != 0) {
+        words.back() |= ~uint64_t(0) << (numSlots % 64);
+    }
+}
+
+uint64_t SlotBitmap::rangeMask(int from, int to) {
+    uint64_t upper = (to >= 64) ? ~uint64_t(0) : ((uint64_t(1) << to) - 1);
+    return upper & (~uint64_t(0) << from);
+}
+
+int SlotBitmap::freeCount() const {
+    int busy = 0;
+    for (uint64_t word : words) {
+        busy += __builtin_popcountll(word);
+    }
+    return (int)words.size() * 64 - busy;
+}
+
+bool SlotBitmap::test(int slot) const {
+    if (slot < 0 || slot >= numSlots) {
+        return true;
+    }
+    return (words[slot >> 6] >> (slot & 63)) & 1;
+}
+
+bool SlotBitmap::isFree(int begin, int end) const {
+    if (begin >= end) {
+        return true;
+    }
+    if (begin < 0 || end > numSlots) {
+        return false;
+    }
+    int firstWord = begin >> 6;
+    int lastWord = (end - 1) >> 6;
+    if (firstWord == lastWord) {
+        return (words[firstWord] & rangeMask(begin & 63, ((end - 1) & 63) + 1)) == 0;
+    }
+    if (words[firstWord] & rangeMask(begin & 63, 64)) {
+        return false;
+    }
+    for (int w = firstWord + 1; w < lastWord; w++) {
+        if (words[w]) {
+            return false;
+        }
+    }
+    return (words[lastWord] & rangeMask(0, ((end - 1) & 63) + 1)) == 0;
+}
+
+void SlotBitmap::reserve(int begin, int end) {
+    if (begin < 0) begin = 0;
+    if (end > numSlots) end = numSlots;
+    for (int slot = begin; slot < end; ) {
+        int w = slot >> 6;
+        int to = min(end - (w << 6), 64);
+        words[w] |= rangeMask(slot & 63, to);
+        slot = (w + 1) << 6;
+    }
+}
+
+void SlotBitmap::release(int begin, int end) {
+    if (begin < 0) begin = 0;
+    if (end > numSlots) end = numSlots;
+    for (int slot = begin; slot < end; ) {
+        int w = slot >> 6;
+        int to = min(end - (w << 6), 64);
+        words[w] &= ~rangeMask(slot & 63, to);
+        slot = (w + 1) << 6;
+    }
+}
+
+int SlotBitmap::nextFree(int from) const {
+    if (from < 0) from = 0;
+    if (from >= numSlots) {
+        return numSlots;
+    }
+    int w = from >> 6;
+    uint64_t free = ~words[w] & (~uint64_t(0) << (from & 63));
+    while (!free) {
+        if (++w >= (int)words.size()) {
+            return numSlots;
+        }
+        free = ~words[w];
+    }
+    return min((w << 6) + __builtin_ctzll(free), numSlots);
+}
+
+int SlotBitmap::nextBusy(int from) const {
+    if (from < 0) from = 0;
+    if (from >= numSlots) {
+        return numSlots;
+    }
+    int w = from >> 6;
+    uint64_t busy = words[w] & (~uint64_t(0) << (from & 63));
+    while (!busy) {
+        if (++w >= (int)words.size()) {
+            return numSlots;
+        }
+        busy = words[w];
+    }
+    return min((w << 6) + __builtin_ctzll(busy), numSlots);
+}
+
+int SlotBitmap::findFreeRun(int from, int length) const {
+    if (from < 0) from = 0;
+    if (length <= 0) {
+        return from <= numSlots ? from : -1;
+    }
+    int start = nextFree(from);
+    while (start + length <= numSlots) {
+        int end = nextBusy(start);
+        if (end - start >= length) {
+            return start;
+        }
+        start = nextFree(end);
+    }
+    return -1;
+}
+
+void SlotBitmap::freeRunStarts(int length, vector<uint64_t>& starts) const {
+    int n = (int)words.size();
+    starts.resize(n);
+    for (int w = 0; w < n; w++) {
+        starts[w] = ~words[w];
+    }
+
+    // Runs of length 2m are runs of length m whose successor m slots on is
+    // also a run start, so `length` is reached in O(log length) shifts
+    vector<uint64_t> shifted(n);
+    for (int covered = 1; covered < length; ) {
+        int step = min(covered, length - covered);
+        int wordShift = step >> 6;
+        int bitShift = step & 63;
+        for (int w = 0; w < n; w++) {
+            uint64_t lo = (w + wordShift < n) ? starts[w + wordShift] : 0;
+            uint64_t hi = (w + wordShift + 1 < n) ? starts[w + wordShift + 1] : 0;
+            shifted[w] = bitShift ? (lo >> bitShift) | (hi << (64 - bitShift)) : lo;
+        }
+        for (int w = 0; w < n; w++) {
+            starts[w] &= shifted[w];
+        }
+        covered += step;
+    }
+}
@@ -0,0 +1,73 @@
+#include "core/StartTable.h"
+
+#include <algorithm>
+
+using namespace std;
+
+StartTable::StartTable(const vector<SlotBitmap>& panels, int length)
+    : length(length), numPanels((int)panels.size()) {
+    int numSlots = panels.empty() ? 0 : panels[0].size();
+    freeCount.assign(numSlots, 0);
+    closed = SlotBitmap(numSlots);
+    closed.reserve(0, numSlots);
+    if (length <= 0) {
+        return;
+    }
+
+    vector<uint64_t> starts;
+    for (const SlotBitmap& panel : panels) {
+        panel.freeRunStarts(length, starts);
+        for (int w = 0; w < (int)starts.size(); w++) {
+            for (uint64_t bits = starts[w]; bits; bits &= bits - 1) {
+                int slot = (w << 6) + __builtin_ctzll(bits);
+                if (slot < numSlots) {
+                    freeCount[slot]++;
+                }
+            }
+        }
+    }
+    for (int slot = 0; slot < numSlots; slot++) {
+        if (freeCount[slot] > 0) {
+            closed.release(slot, slot + 1);
+        }
+    }
+}
+
+void StartTable::adjust(const SlotBitmap& panel, int begin, int end, int delta) {
+    if (length <= 0) {
+        return;
+    }
+    // Walk the panel's free runs; every start in a run long enough for a
+    // round is counted
+    int last = min(end, (int)freeCount.size() - length + 1);
+    for (int slot = panel.nextFree(max(begin - length + 1, 0)); slot < last; ) {
+        int busy = panel.nextBusy(slot);
+        int stop = min(busy - length + 1, last);
+        if (slot < stop && delta > 0) {
+            closed.release(slot, stop);
+        }
+        for (; slot < stop; slot++) {
+            freeCount[slot] += delta;
+            if (freeCount[slot] == 0) {
+                closed.reserve(slot, slot + 1);
+            }
+        }
+        slot = panel.nextFree(busy);
+    }
+}
+
+int StartTable::panelsFree(int slot) const {
+    if (length <= 0) {
+        return numPanels;
+    }
+    return slot >= 0 && slot < (int)freeCount.size() ? freeCount[slot] : 0;
+}
+
+int StartTable::nextStart(int from) const {
+    if (from < 0) from = 0;
+    if (length <= 0) {
+        return numPanels > 0 && from <= (int)freeCount.size() ? from : -1;
+    }
+    int slot = closed.nextFree(from);
+    return slot < closed.size() ? slot : -1;
+}
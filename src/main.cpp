@@ -29,6 +29,9 @@ int main(int argc, char *argv[])
     // Default configuration
     int port = 8080;
     std::string dbPath = "/home/parakh/crisp-platform/data/crisp_platform.db";
+    std::string cacheDir;
+    size_t cacheMaxFiles = 1000;
+    size_t cacheEntries = 64;
 
     // Parse command line arguments for port and db path
     for (int i = 1; i < argc; i++)
@@ -42,12 +45,27 @@ int main(int argc, char *argv[])
         {
             dbPath = argv[++i];
         }
+        else if (arg == "--cache-dir" && i + 1 < argc)
+        {
+            cacheDir = argv[++i];
+        }
+        else if (arg == "--cache-max-files" && i + 1 < argc)
+        {
+            cacheMaxFiles = std::stoul(argv[++i]);
+        }
+        else if (arg == "--cache-entries" && i + 1 < argc)
+        {
+            cacheEntries = std::stoul(argv[++i]);
+        }
         else if (arg == "--help" || arg == "-h")
         {
             std::cout << "\nUsage: " << argv[0] << " [options]" << std::endl;
             std::cout << "Options:" << std::endl;
             std::cout << "  --port <port>    Server port (default: 8080)" << std::endl;
             std::cout << "  --db <path>      Database path (default: data/crisp_platform.db)" << std::endl;
+            std::cout << "  --cache-dir <dir> Keep generated schedules on disk (default: memory only)" << std::endl;
+            std::cout << "  --cache-max-files <n> Most schedules kept on disk, oldest deleted first (default: 1000)" << std::endl;
+            std::cout << "  --cache-entries <n> Most schedules kept in memory, least recently used dropped first (default: 64)" << std::endl;
             std::cout << "  --help, -h       Show this help message" << std::endl;
             return 0;
         }
@@ -67,6 +85,12 @@ int main(int argc, char *argv[])
         // Create and setup web server
         globalServer = std::make_unique<WebServer>(port);
         globalServer->setDatabase(database);
+        globalServer->setCacheCapacity(cacheEntries);
+        if (!cacheDir.empty())
+        {
+            globalServer->setCacheDirectory(cacheDir, cacheMaxFiles);
+            std::cout << "Schedule cache directory: " << cacheDir << " (up to " << cacheMaxFiles << " files)" << std::endl;
+        }
         globalServer->setupRoutes();
 
         // Setup signal handlers for graceful shutdown
@@ -0,0 +1,181 @@
+#include "platform/result_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+ResultCache::ResultCache(size_t capacity) : capacity_(capacity) {}
+
+void ResultCache::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    while (entries_.size() > capacity_)
+    {
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+}
+
+// Lists the <key>.json files already in the directory, newest first, and
+// deletes the least recently written or read beyond maxFiles
+void ResultCache::setDirectory(const std::string &directory, size_t maxFiles)
+{
+    std::filesystem::create_directories(directory);
+    std::error_code error;
+    std::vector<std::pair<std::filesystem::file_time_type, uint64_t>> files;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+        const std::filesystem::path &path = entry.path();
+        unsigned long long key;
+        char rest;
+        if (path.extension() != ".json" || sscanf(path.stem().string().c_str(), "%16llx%c", &key, &rest) != 1)
+            continue;
+        auto time = entry.last_write_time(error);
+        if (!error)
+            files.push_back({time, key});
+    }
+    std::sort(files.rbegin(), files.rend());
+    for (size_t i = maxFiles; i < files.size(); i++)
+        std::filesystem::remove(pathFor(directory, files[i].second), error);
+    files.resize(std::min(files.size(), maxFiles));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    directory_ = directory;
+    maxFiles_ = maxFiles;
+    files_.clear();
+    fileIndex_.clear();
+    for (const auto &file : files)
+    {
+        files_.push_back(file.second);
+        fileIndex_[file.second] = std::prev(files_.end());
+    }
+}
+
+std::string ResultCache::pathFor(const std::string &directory, uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.json", (unsigned long long)key);
+    return (std::filesystem::path(directory) / name).string();
+}
+
+// Inserts or refreshes an entry at the front, evicting from the back
+void ResultCache::remember(uint64_t key, std::string body)
+{
+    auto it = index_.find(key);
+    if (it != index_.end())
+        entries_.erase(it->second);
+    entries_.push_front({key, std::move(body)});
+    index_[key] = entries_.begin();
+    while (entries_.size() > capacity_)
+    {
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+}
+
+std::vector<uint64_t> ResultCache::touchFile(uint64_t key)
+{
+    auto it = fileIndex_.find(key);
+    if (it != fileIndex_.end())
+        files_.splice(files_.begin(), files_, it->second);
+    else
+    {
+        files_.push_front(key);
+        fileIndex_[key] = files_.begin();
+    }
+    std::vector<uint64_t> evicted;
+    while (files_.size() > maxFiles_)
+    {
+        evicted.push_back(files_.back());
+        fileIndex_.erase(files_.back());
+        files_.pop_back();
+    }
+    return evicted;
+}
+
+// Files are read and written outside the lock so disk I/O never stalls
+// requests that hit memory
+bool ResultCache::get(uint64_t key, std::string &body)
+{
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end())
+        {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            body = it->second->body;
+            return true;
+        }
+        directory = directory_;
+    }
+    if (directory.empty())
+        return false;
+
+    std::string path = pathFor(directory, key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    body = contents.str();
+
+    // Pruning goes by file time, so a hit marks the file as recently used
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    remember(key, body);
+    auto it = fileIndex_.find(key);
+    if (it != fileIndex_.end())
+        files_.splice(files_.begin(), files_, it->second);
+    return true;
+}
+
+void ResultCache::put(uint64_t key, const std::string &body)
+{
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        remember(key, body);
+        directory = directory_;
+    }
+    if (directory.empty())
+        return;
+
+    // Written under a per-thread temporary name and renamed, so readers never
+    // see half a file and concurrent writers of one key do not interleave
+    std::string path = pathFor(directory, key);
+    std::string temporary = path + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file << body;
+        if (!file)
+        {
+            std::cerr << "Cannot write cache file " << temporary << std::endl;
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        std::cerr << "Cannot write cache file " << path << ": " << error.message() << std::endl;
+        return;
+    }
+
+    std::vector<uint64_t> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (directory_ != directory)
+            return;
+        evicted = touchFile(key);
+    }
+    for (uint64_t old : evicted)
+        std::filesystem::remove(pathFor(directory, old), error);
+}
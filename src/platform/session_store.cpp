@@ -0,0 +1,31 @@
+#include "platform/session_store.h"
+
+bool SessionStore::add(const std::shared_ptr<SchedulerSession> &session)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.emplace(session->name, session).second;
+}
+
+std::shared_ptr<SchedulerSession> SessionStore::get(const std::string &name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(name);
+    return it == sessions_.end() ? nullptr : it->second;
+}
+
+bool SessionStore::remove(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.erase(name) > 0;
+}
+
+std::vector<std::shared_ptr<SchedulerSession>> SessionStore::list() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<SchedulerSession>> result;
+    for (const auto &entry : sessions_)
+    {
+        result.push_back(entry.second);
+    }
+    return result;
+}
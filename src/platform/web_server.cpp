@@ -1,9 +1,138 @@
 #include "platform/web_server.h"
+#include "core/Fingerprint.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
 
-WebServer::WebServer(int port) : port_(port)
+static const std::pair<const char *, StudentOrdering> orderingNames[] = {
+    {"fewest-shortlists", StudentOrdering::FewestShortlists},
+    {"most-constrained", StudentOrdering::MostConstrained},
+    {"capacity-ratio", StudentOrdering::CapacityRatio},
+    {"random", StudentOrdering::Randomized}
+};
+
+static const std::pair<const char *, Objective> objectiveNames[] = {
+    {"feasible", Objective::Feasible},
+    {"makespan", Objective::Makespan},
+    {"idle-gaps", Objective::IdleGaps},
+    {"panel-balance", Objective::PanelBalance}
+};
+
+static const std::pair<const char *, SearchStrategy> strategyNames[] = {
+    {"step", SearchStrategy::Step},
+    {"jump", SearchStrategy::Jump}
+};
+
+static const std::pair<const char *, SolverBackend> backendNames[] = {
+    {"backtracking", SolverBackend::Backtracking},
+    {"propagation", SolverBackend::Propagation}
+};
+
+static const std::pair<const char *, SchedulingMode> modeNames[] = {
+    {"student-centric", SchedulingMode::StudentCentric},
+    {"company-centric", SchedulingMode::CompanyCentric}
+};
+
+template <typename Enum, size_t N>
+static std::string enumToString(const std::pair<const char *, Enum> (&names)[N], Enum value)
+{
+    for (const auto &entry : names)
+    {
+        if (entry.second == value)
+            return entry.first;
+    }
+    return "";
+}
+
+// Looks name up in names; throws std::invalid_argument naming the option if absent
+template <typename Enum, size_t N>
+static Enum enumFromString(const std::pair<const char *, Enum> (&names)[N], const std::string &name, const char *option)
+{
+    for (const auto &entry : names)
+    {
+        if (name == entry.first)
+            return entry.second;
+    }
+    throw std::invalid_argument(std::string("Unknown ") + option + ": " + name);
+}
+
+// Reads [{"day", "startTime", "endTime"}] in minutes of the day; a window
+// without "day" repeats on every day
+static std::vector<TimeSlot> parseWindows(const json &windows, int numDays)
+{
+    std::vector<TimeSlot> result;
+    for (const auto &window : windows)
+    {
+        int startTime = window.at("startTime");
+        int endTime = window.at("endTime");
+        if (endTime <= startTime)
+            throw std::invalid_argument("Window must end after it starts");
+        int firstDay = window.value("day", 0);
+        int lastDay = window.contains("day") ? firstDay : numDays - 1;
+        for (int day = firstDay; day <= lastDay; day++)
+        {
+            result.push_back(TimeSlot(day * MINUTES_PER_DAY + startTime, day * MINUTES_PER_DAY + endTime));
+        }
+    }
+    return result;
+}
+
+static json windowsToJson(const std::vector<TimeSlot> &windows)
+{
+    json result = json::array();
+    for (const auto &window : windows)
+    {
+        int day = window.startTime / MINUTES_PER_DAY;
+        result.push_back({
+            {"day", day},
+            {"startTime", window.startTime - day * MINUTES_PER_DAY},
+            {"endTime", window.endTime - day * MINUTES_PER_DAY}
+        });
+    }
+    return result;
+}
+
+static int dayCount(const std::vector<TimeSlot> &days)
+{
+    int count = 0;
+    for (const auto &day : days)
+        count = std::max(count, day.startTime / MINUTES_PER_DAY + 1);
+    return count;
+}
+
+// 64-bit hashes go out as 16 hex digits; JSON numbers lose precision past 2^53
+static std::string hashToHex(uint64_t hash)
+{
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)hash);
+    return buffer;
+}
+
+// Every member of a portfolio is a full copy of the scheduler, so the size is
+// capped; throws std::invalid_argument when it is out of range
+static int portfolioSizeOf(const json &requestData)
+{
+    int size = requestData.value("portfolioSize", 1);
+    if (size < 1 || size > InterviewScheduler::maxPortfolioSize)
+        throw std::invalid_argument("portfolioSize must be between 1 and " + std::to_string(InterviewScheduler::maxPortfolioSize));
+    return size;
+}
+
+static Student studentFromJson(const json &body, int numDays)
+{
+    Student student(body.at("id"), body.value("name", ""));
+    student.shortlistedCompanies = body.at("shortlistedCompanies").get<std::vector<std::string>>();
+    if (body.contains("unavailable"))
+        student.unavailable = parseWindows(body["unavailable"], numDays);
+    if (body.contains("priorities"))
+        student.priorities = body["priorities"].get<std::vector<std::string>>();
+    return student;
+}
+
+WebServer::WebServer(int port) : port_(port), cache_(64)
 {
     setupCORS();
 }
@@ -13,6 +142,16 @@ void WebServer::setDatabase(std::shared_ptr<Database> db)
     db_ = db;
 }
 
+void WebServer::setCacheCapacity(size_t entries)
+{
+    cache_.setCapacity(entries);
+}
+
+void WebServer::setCacheDirectory(const std::string &directory, size_t maxFiles)
+{
+    cache_.setDirectory(directory, maxFiles);
+}
+
 void WebServer::setupCORS()
 {
     server_.set_pre_routing_handler([](const httplib::Request &req, httplib::Response &res)
@@ -42,6 +181,60 @@ void WebServer::setupRoutes()
     server_.Post("/api/schedule/generate", [this](const httplib::Request &req, httplib::Response &res) { handleGenerateSchedule(req, res); });
     server_.Get("/api/schedule", [this](const httplib::Request &req, httplib::Response &res) { handleGetSchedule(req, res); });
     server_.Get("/api/statistics", [this](const httplib::Request &req, httplib::Response &res) { handleGetStatistics(req, res); });
+
+    // Long-lived scheduler sessions
+    server_.Post("/api/sessions", [this](const httplib::Request &req, httplib::Response &res) { handleCreateSession(req, res); });
+    server_.Get("/api/sessions", [this](const httplib::Request &req, httplib::Response &res) { handleListSessions(req, res); });
+    server_.Delete("/api/sessions/:name", [this](const httplib::Request &req, httplib::Response &res) { handleDeleteSession(req, res); });
+    server_.Get("/api/sessions/:name", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this](SchedulerSession &session, const json &) { return sessionToJson(session); });
+    });
+    server_.Get("/api/sessions/:name/snapshot", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this](SchedulerSession &session, const json &) { return sessionSnapshot(session); });
+    });
+    server_.Post("/api/sessions/:name/regenerate", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this](SchedulerSession &session, const json &body) {
+            applySchedulerOptions(body, session.scheduler);
+            json response = solveSchedule(body, session.scheduler, session.conflicts);
+            response["session"] = session.name;
+            response["revision"] = ++session.revision;
+            return response;
+        });
+    });
+    server_.Post("/api/sessions/:name/improve", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this](SchedulerSession &session, const json &) {
+            return sessionDeltaToJson(session, session.scheduler.improveSchedule());
+        });
+    });
+    server_.Post("/api/sessions/:name/students", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this](SchedulerSession &session, const json &body) {
+            Student student = studentFromJson(body, dayCount(session.scheduler.getDays()));
+            auto conflicts = session.scheduler.addLateStudent(student);
+            return sessionDeltaToJson(session, conflicts);
+        });
+    });
+    server_.Delete("/api/sessions/:name/students/:id", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this, &req](SchedulerSession &session, const json &) {
+            return sessionDeltaToJson(session, session.scheduler.withdrawStudent(req.path_params.at("id")));
+        });
+    });
+    server_.Post("/api/sessions/:name/shortlists", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this](SchedulerSession &session, const json &body) {
+            auto conflicts = session.scheduler.addLateShortlist(body.at("studentId"), body.at("companyName"));
+            return sessionDeltaToJson(session, conflicts);
+        });
+    });
+    server_.Delete("/api/sessions/:name/companies/:company", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this, &req](SchedulerSession &session, const json &) {
+            return sessionDeltaToJson(session, session.scheduler.withdrawCompany(req.path_params.at("company")));
+        });
+    });
+    server_.Post("/api/sessions/:name/panels/drop", [this](const httplib::Request &req, httplib::Response &res) {
+        withSession(req, res, [this](SchedulerSession &session, const json &body) {
+            auto conflicts = session.scheduler.dropPanel(body.at("companyName"), body.at("panelId"));
+            return sessionDeltaToJson(session, conflicts);
+        });
+    });
 }
 
 void WebServer::handleGetRoot(const httplib::Request &req, httplib::Response &res)
@@ -50,7 +243,7 @@ void WebServer::handleGetRoot(const httplib::Request &req, httplib::Response &re
         {"message", "CRISP Platform API"},
         {"version", "1.0.0"},
         {"status", "running"},
-        {"endpoints", {"/api/schedule/generate - POST", "/api/schedule - GET", "/api/students - GET/POST", "/api/companies - GET/POST", "/api/statistics - GET"}}
+        {"endpoints", {"/api/schedule/generate - POST", "/api/schedule - GET", "/api/sessions - GET/POST", "/api/sessions/:name - GET/DELETE", "/api/students - GET/POST", "/api/companies - GET/POST", "/api/statistics - GET"}}
     };
     sendJsonResponse(res, response);
 }
@@ -66,76 +259,281 @@ void WebServer::handleGenerateSchedule(const httplib::Request &req, httplib::Res
 
         // Initialize scheduler
         InterviewScheduler scheduler;
+        loadScheduler(requestData, scheduler);
 
-        // Default time slot: 9 AM to 5 PM
-        int startTime = 9 * 60; // 9 AM
-        int endTime = 17 * 60;  // 5 PM
+        // Results are a pure function of the loaded input and the solve
+        // options, except under a time budget where they depend on machine speed
+        int portfolioSize = portfolioSizeOf(requestData);
+        bool cacheable = requestData.value("cache", true) && requestData.value("timeBudgetMs", 0) <= 0;
+        Fingerprint key;
+        key.add(scheduler.inputFingerprint());
+        key.add(portfolioSize);
 
-        if (requestData.contains("timeSlot"))
+        std::string body;
+        if (cacheable && cache_.get(key.value(), body))
         {
-            startTime = requestData["timeSlot"].value("startTime", startTime);
-            endTime = requestData["timeSlot"].value("endTime", endTime);
+            std::cout << "Served cached schedule " << hashToHex(key.value()) << std::endl;
+            res.set_content(body, "application/json");
+            return;
         }
 
-        scheduler.initialize(TimeSlot(startTime, endTime));
+        std::vector<std::string> conflicts;
+        json response = solveSchedule(requestData, scheduler, conflicts);
+        response["statistics"]["cached"] = false;
+        sendJsonResponse(res, response);
 
-        // Add companies from request
-        if (requestData.contains("companies"))
+        if (cacheable)
         {
-            for (const auto &company : requestData["companies"])
-            {
-                scheduler.addCompany(company["name"], company["durationPerRound"], company["numRounds"], company["numPanels"]);
-                std::cout << "Added company: " << company["name"] << std::endl;
-            }
+            response["statistics"]["cached"] = true;
+            cache_.put(key.value(), response.dump(2));
+        }
+    }
+    catch (const json::parse_error &e)
+    {
+        std::cerr << "JSON parse error: " << e.what() << std::endl;
+        sendErrorResponse(res, "Invalid JSON format: " + std::string(e.what()), 400);
+    }
+    catch (const json::exception &e)
+    {
+        std::cerr << "Invalid request: " << e.what() << std::endl;
+        sendErrorResponse(res, "Invalid request: " + std::string(e.what()), 400);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Invalid scheduler option: " << e.what() << std::endl;
+        sendErrorResponse(res, e.what(), 400);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error generating schedule: " << e.what() << std::endl;
+        sendErrorResponse(res, "Error generating schedule: " + std::string(e.what()), 500);
+    }
+}
+
+// Fills a scheduler from a generate-style request body
+void WebServer::loadScheduler(const json &requestData, InterviewScheduler &scheduler)
+{
+    // Default time slot: 9 AM to 5 PM
+    int startTime = 9 * 60; // 9 AM
+    int endTime = 17 * 60;  // 5 PM
+
+    if (requestData.contains("timeSlot"))
+    {
+        startTime = requestData["timeSlot"].value("startTime", startTime);
+        endTime = requestData["timeSlot"].value("endTime", endTime);
+    }
+
+    // Multi-day drives list one window per day instead
+    std::vector<TimeSlot> days;
+    if (requestData.contains("days"))
+    {
+        int index = 0;
+        for (const auto &day : requestData["days"])
+        {
+            int offset = day.value("day", index++) * MINUTES_PER_DAY;
+            days.push_back(TimeSlot(offset + day.at("startTime").get<int>(), offset + day.at("endTime").get<int>()));
         }
+    }
+    else
+    {
+        days.push_back(TimeSlot(startTime, endTime));
+    }
+    if (days.empty())
+        throw std::invalid_argument("days must not be empty");
+    for (size_t i = 0; i < days.size(); i++)
+    {
+        if (days[i].endTime <= days[i].startTime)
+            throw std::invalid_argument("Window must end after it starts");
+        if (i > 0 && days[i].startTime < days[i - 1].endTime)
+            throw std::invalid_argument("days must be in order and must not overlap");
+    }
+    scheduler.initialize(days);
 
-        // Add students from request
-        if (requestData.contains("students"))
+    int numDays = dayCount(days);
+    if (requestData.contains("breaks"))
+    {
+        for (const auto &slot : parseWindows(requestData["breaks"], numDays))
+            scheduler.addBreak(slot);
+    }
+    applySchedulerOptions(requestData, scheduler);
+
+    // Add companies from request
+    if (requestData.contains("companies"))
+    {
+        for (const auto &company : requestData["companies"])
         {
-            for (const auto &studentJson : requestData["students"])
+            std::string name = company.at("name");
+            int numRounds = company.at("numRounds");
+            int numPanels = company.at("numPanels");
+            // Schedules store rounds and panel ids in 16 bits
+            if (numRounds < 0 || numRounds > ScheduleStore::maxColumnValue || numPanels < 0 || numPanels > ScheduleStore::maxColumnValue)
+                throw std::invalid_argument("numRounds and numPanels must be between 0 and " + std::to_string(ScheduleStore::maxColumnValue) + " for company " + name);
+            scheduler.addCompany(name, company.at("durationPerRound"), numRounds, numPanels);
+            if (company.contains("availability"))
+            {
+                scheduler.setCompanyAvailability(name, parseWindows(company["availability"], numDays));
+            }
+            if (company.contains("panelAvailability"))
+            {
+                for (const auto &panel : company["panelAvailability"])
+                {
+                    if (!scheduler.setPanelAvailability(name, panel.at("panelId"), parseWindows(panel.at("windows"), numDays)))
+                        throw std::invalid_argument("Unknown panel for company " + name);
+                }
+            }
+            if (company.contains("droppedPanels"))
             {
-                std::string id = studentJson["id"];
-                std::string name = studentJson.value("name", "");
-                std::vector<std::string> shortlisted = studentJson["shortlistedCompanies"];
-                scheduler.addStudent(id, name, shortlisted);
+                for (int panelId : company["droppedPanels"])
+                {
+                    if (!scheduler.dropPanel(name, panelId).empty())
+                        throw std::invalid_argument("Unknown panel for company " + name);
+                }
             }
+            std::cout << "Added company: " << name << std::endl;
         }
+    }
 
-        // Generate schedule
-        auto conflicts = scheduler.generateSchedule();
-        auto schedule = scheduler.getSchedule();
+    // Add students from request
+    if (requestData.contains("students"))
+    {
+        for (const auto &studentJson : requestData["students"])
+        {
+            scheduler.addStudent(studentFromJson(studentJson, numDays));
+        }
+    }
+}
 
-        // Prepare response
-        json response;
-        response["success"] = true;
-        response["conflicts"] = conflicts;
-        response["schedule"] = json::array();
-        response["statistics"] = {
-            {"totalInterviews", schedule.size()},
-            {"totalConflicts", conflicts.size()},
-            {"successRate", conflicts.empty() ? 100.0 : 0.0}
+// Runs a full generation, optionally as a portfolio of orderings within a time budget
+json WebServer::solveSchedule(const json &requestData, InterviewScheduler &scheduler, std::vector<std::string> &conflicts)
+{
+    json portfolio;
+    auto solveStart = std::chrono::steady_clock::now();
+    std::chrono::milliseconds timeBudget(requestData.value("timeBudgetMs", 0));
+    int portfolioSize = portfolioSizeOf(requestData);
+
+    // Sessions reuse their scheduler, so an earlier budget must not carry over
+    scheduler.setDeadline(std::chrono::steady_clock::time_point::max());
+
+    if (portfolioSize > 1)
+    {
+        PortfolioResult result = scheduler.generatePortfolioSchedule(portfolioSize, timeBudget);
+        conflicts = result.conflicts;
+        portfolio = {
+            {"members", result.members},
+            {"ordering", enumToString(orderingNames, result.ordering)},
+            {"seed", result.seed},
+            {"makespan", result.makespan}
         };
+    }
+    else
+    {
+        if (timeBudget.count() > 0)
+            scheduler.setDeadline(solveStart + timeBudget);
+        conflicts = scheduler.generateSchedule();
+    }
 
-        for (const auto &interview : schedule)
-        {
-            response["schedule"].push_back(interviewToJson(interview));
-        }
+    double generationTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - solveStart).count();
 
-        std::cout << "Generated " << schedule.size() << " interviews with " << conflicts.size() << " conflicts\n";
+    json response = scheduleResponse(scheduler, conflicts);
+    response["statistics"]["generationTimeMs"] = generationTimeMs;
+    if (!portfolio.is_null())
+        response["portfolio"] = portfolio;
 
-        sendJsonResponse(res, response);
+    std::cout << "Generated " << response["statistics"]["totalInterviews"] << " interviews with " << conflicts.size() << " conflicts\n";
+    return response;
+}
+
+json WebServer::scheduleResponse(const InterviewScheduler &scheduler, const std::vector<std::string> &conflicts)
+{
+    auto schedule = scheduler.getSchedule();
+    const ScheduleStats &stats = scheduler.getLastRunStats();
+    ScheduleMetrics metrics = scheduler.getScheduleMetrics();
+
+    json response;
+    response["success"] = true;
+    response["conflicts"] = conflicts;
+    response["schedule"] = json::array();
+    response["statistics"] = {
+        {"totalInterviews", schedule.size()},
+        {"totalConflicts", conflicts.size()},
+        {"successRate", stats.studentsTotal == 0 ? 100.0 : 100.0 * stats.studentsPlaced / stats.studentsTotal},
+        {"studentsPlaced", stats.studentsPlaced},
+        {"studentsTotal", stats.studentsTotal},
+        {"nodesExplored", stats.nodesExplored},
+        {"budgetExhausted", stats.budgetExhausted},
+        {"slotMinutes", scheduler.getTimeSlotDuration()},
+        {"objective", enumToString(objectiveNames, scheduler.getObjective())},
+        {"makespan", metrics.makespan},
+        {"idleMinutes", metrics.idleMinutes},
+        {"panelSpread", metrics.panelSpread},
+        {"seed", scheduler.getSeed()},
+        {"fingerprint", hashToHex(scheduler.inputFingerprint())},
+        {"scheduleHash", hashToHex(scheduler.scheduleHash())}
+    };
+
+    for (const auto &interview : schedule)
+    {
+        response["schedule"].push_back(interviewToJson(interview));
     }
-    catch (const json::parse_error &e)
+    return response;
+}
+
+// Optional solver settings shared by every scheduling request
+void WebServer::applySchedulerOptions(const json &requestData, InterviewScheduler &scheduler)
+{
+    if (requestData.contains("searchStrategy"))
+        scheduler.setSearchStrategy(enumFromString(strategyNames, requestData["searchStrategy"], "searchStrategy"));
+
+    if (requestData.contains("backend"))
+        scheduler.setSolverBackend(enumFromString(backendNames, requestData["backend"], "backend"));
+
+    if (requestData.contains("schedulingMode"))
+        scheduler.setSchedulingMode(enumFromString(modeNames, requestData["schedulingMode"], "schedulingMode"));
+
+    if (requestData.contains("objective"))
+        scheduler.setObjective(enumFromString(objectiveNames, requestData["objective"], "objective"));
+
+    if (requestData.contains("slotMinutes"))
     {
-        std::cerr << "JSON parse error: " << e.what() << std::endl;
-        sendErrorResponse(res, "Invalid JSON format: " + std::string(e.what()), 400);
+        int minutes = requestData["slotMinutes"];
+        if (minutes < 0)
+            throw std::invalid_argument("slotMinutes must not be negative");
+        scheduler.setTimeSlotDuration(minutes);
     }
-    catch (const std::exception &e)
+
+    if (requestData.contains("seed"))
     {
-        std::cerr << "Error generating schedule: " << e.what() << std::endl;
-        sendErrorResponse(res, "Error generating schedule: " + std::string(e.what()), 500);
+        scheduler.setSeed(requestData["seed"]);
     }
+
+    if (requestData.contains("workerThreads"))
+    {
+        int threads = requestData["workerThreads"];
+        if (threads < 0 || threads > InterviewScheduler::maxWorkerThreads)
+            throw std::invalid_argument("workerThreads must be between 0 and " + std::to_string(InterviewScheduler::maxWorkerThreads));
+        scheduler.setWorkerThreads(threads);
+    }
+
+    if (requestData.contains("nodeBudget"))
+    {
+        scheduler.setNodeBudget(requestData["nodeBudget"]);
+    }
+
+    if (requestData.contains("localSearch"))
+    {
+        scheduler.setLocalSearch(requestData["localSearch"]);
+    }
+
+    if (requestData.contains("singleRoundMatching"))
+    {
+        scheduler.setSingleRoundMatching(requestData["singleRoundMatching"]);
+    }
+
+    if (requestData.contains("ordering"))
+        scheduler.setStudentOrdering(enumFromString(orderingNames, requestData["ordering"], "ordering"), scheduler.getSeed());
 }
+
 void WebServer::handleGetStatistics(const httplib::Request &req, httplib::Response &res) {
     json response = {
         {"totalStudents", 0},
@@ -148,12 +546,233 @@ void WebServer::handleGetStatistics(const httplib::Request &req, httplib::Respon
 
 void WebServer::handleGetSchedule(const httplib::Request &req, httplib::Response &res)
 {
-    json response = {
-        {"message", "Schedule endpoint - use POST /api/schedule/generate to create schedules"}
-    };
+    if (req.has_param("session"))
+    {
+        auto session = sessions_.get(req.get_param_value("session"));
+        if (!session)
+        {
+            sendErrorResponse(res, "Unknown session: " + req.get_param_value("session"), 404);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(session->mutex);
+        sendJsonResponse(res, sessionToJson(*session));
+        return;
+    }
+    handleListSessions(req, res);
+}
+
+void WebServer::handleCreateSession(const httplib::Request &req, httplib::Response &res)
+{
+    try
+    {
+        json requestData = json::parse(req.body);
+        std::string name = requestData.value("name", "");
+        if (name.empty())
+        {
+            sendErrorResponse(res, "Session name is required", 400);
+            return;
+        }
+        if (sessions_.get(name))
+        {
+            sendErrorResponse(res, "Session already exists: " + name, 409);
+            return;
+        }
+
+        auto session = std::make_shared<SchedulerSession>();
+        session->name = name;
+        loadScheduler(requestData, session->scheduler);
+
+        // A posted snapshot carries its schedule, which is restored rather than re-solved
+        json response;
+        const json &schedule = requestData.contains("schedule") ? requestData["schedule"] : json::array();
+        if (!schedule.empty())
+        {
+            std::vector<Interview> interviews;
+            for (const auto &entry : schedule)
+            {
+                int startTime = entry.at("startTime");
+                interviews.push_back(Interview(entry.at("studentId"), entry.at("companyName"), entry.at("round"),
+                                               TimeSlot(startTime, entry.at("endTime").get<int>()), entry.at("panelId")));
+            }
+            session->conflicts = session->scheduler.restoreSchedule(interviews);
+            response = scheduleResponse(session->scheduler, session->conflicts);
+            response["restored"] = true;
+        }
+        else
+        {
+            response = solveSchedule(requestData, session->scheduler, session->conflicts);
+        }
+
+        if (!sessions_.add(session))
+        {
+            sendErrorResponse(res, "Session already exists: " + name, 409);
+            return;
+        }
+        response["session"] = name;
+        response["revision"] = session->revision;
+        sendJsonResponse(res, response, 201);
+    }
+    catch (const json::parse_error &e)
+    {
+        sendErrorResponse(res, "Invalid JSON format: " + std::string(e.what()), 400);
+    }
+    catch (const json::exception &e)
+    {
+        sendErrorResponse(res, "Invalid request: " + std::string(e.what()), 400);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        sendErrorResponse(res, e.what(), 400);
+    }
+    catch (const std::exception &e)
+    {
+        sendErrorResponse(res, "Error creating session: " + std::string(e.what()), 500);
+    }
+}
+
+void WebServer::handleListSessions(const httplib::Request &, httplib::Response &res)
+{
+    json response = json::array();
+    for (const auto &session : sessions_.list())
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        response.push_back({
+            {"name", session->name},
+            {"revision", session->revision},
+            {"totalInterviews", session->scheduler.getSchedule().size()},
+            {"unscheduledStudents", session->scheduler.getUnscheduledStudents().size()}
+        });
+    }
     sendJsonResponse(res, response);
 }
 
+void WebServer::handleDeleteSession(const httplib::Request &req, httplib::Response &res)
+{
+    std::string name = req.path_params.at("name");
+    if (!sessions_.remove(name))
+    {
+        sendErrorResponse(res, "Unknown session: " + name, 404);
+        return;
+    }
+    sendJsonResponse(res, {{"success", true}});
+}
+
+// Looks up the session named in the path, locks it and runs action on it
+void WebServer::withSession(const httplib::Request &req, httplib::Response &res,
+                            const std::function<json(SchedulerSession &, const json &)> &action)
+{
+    std::string name = req.path_params.at("name");
+    auto session = sessions_.get(name);
+    if (!session)
+    {
+        sendErrorResponse(res, "Unknown session: " + name, 404);
+        return;
+    }
+
+    try
+    {
+        json body = req.body.empty() ? json::object() : json::parse(req.body);
+        std::lock_guard<std::mutex> lock(session->mutex);
+        sendJsonResponse(res, action(*session, body));
+    }
+    catch (const json::parse_error &e)
+    {
+        sendErrorResponse(res, "Invalid JSON format: " + std::string(e.what()), 400);
+    }
+    catch (const json::exception &e)
+    {
+        sendErrorResponse(res, "Invalid request: " + std::string(e.what()), 400);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        sendErrorResponse(res, e.what(), 400);
+    }
+    catch (const std::exception &e)
+    {
+        sendErrorResponse(res, "Error updating session: " + std::string(e.what()), 500);
+    }
+}
+
+json WebServer::sessionToJson(SchedulerSession &session)
+{
+    json response = scheduleResponse(session.scheduler, session.conflicts);
+    response["session"] = session.name;
+    response["revision"] = session.revision;
+    response["unscheduledStudents"] = session.scheduler.getUnscheduledStudents();
+    return response;
+}
+
+// Result of an incremental edit: only the conflicts it caused, plus a summary
+json WebServer::sessionDeltaToJson(SchedulerSession &session, const std::vector<std::string> &conflicts)
+{
+    session.revision++;
+    return {
+        {"success", true},
+        {"session", session.name},
+        {"revision", session.revision},
+        {"conflicts", conflicts},
+        {"totalInterviews", session.scheduler.getSchedule().size()},
+        {"unscheduledStudents", session.scheduler.getUnscheduledStudents()}
+    };
+}
+
+// Everything needed to recreate the session, in the generate request format
+json WebServer::sessionSnapshot(SchedulerSession &session)
+{
+    InterviewScheduler &scheduler = session.scheduler;
+    TimeSlot window = scheduler.getAvailableSlot();
+    json snapshot = {
+        {"name", session.name},
+        {"revision", session.revision},
+        {"timeSlot", {{"startTime", window.startTime}, {"endTime", window.endTime}}},
+        {"days", windowsToJson(scheduler.getDays())},
+        {"breaks", windowsToJson(scheduler.getBreaks())},
+        {"searchStrategy", enumToString(strategyNames, scheduler.getSearchStrategy())},
+        {"backend", enumToString(backendNames, scheduler.getSolverBackend())},
+        {"schedulingMode", enumToString(modeNames, scheduler.getSchedulingMode())},
+        {"ordering", enumToString(orderingNames, scheduler.getStudentOrdering())},
+        {"seed", scheduler.getSeed()},
+        {"objective", enumToString(objectiveNames, scheduler.getObjective())},
+        {"slotMinutes", scheduler.getRequestedTimeSlotDuration()},
+        {"workerThreads", scheduler.getWorkerThreads()},
+        {"nodeBudget", scheduler.getNodeBudget()},
+        {"localSearch", scheduler.getLocalSearch()},
+        {"singleRoundMatching", scheduler.getSingleRoundMatching()},
+        {"companies", json::array()},
+        {"students", json::array()},
+        {"schedule", json::array()}
+    };
+    for (const auto &company : scheduler.getCompanies())
+    {
+        json entry = companyToJson(company);
+        entry["availability"] = windowsToJson(scheduler.getCompanyAvailability(company.name));
+        entry["panelAvailability"] = json::array();
+        for (int panelId = 0; panelId < company.numPanels; panelId++)
+        {
+            auto windows = scheduler.getPanelAvailability(company.name, panelId);
+            if (!windows.empty())
+                entry["panelAvailability"].push_back({{"panelId", panelId}, {"windows", windowsToJson(windows)}});
+        }
+        entry["droppedPanels"] = scheduler.getDroppedPanels(company.name);
+        snapshot["companies"].push_back(entry);
+    }
+    for (const auto &student : scheduler.getStudents())
+    {
+        snapshot["students"].push_back({
+            {"id", student.rollNumber},
+            {"name", student.name},
+            {"shortlistedCompanies", student.shortlistedCompanies},
+            {"unavailable", windowsToJson(student.unavailable)},
+            {"priorities", student.priorities}
+        });
+    }
+    for (const auto &interview : scheduler.getSchedule())
+    {
+        snapshot["schedule"].push_back(interviewToJson(interview));
+    }
+    return snapshot;
+}
+
 void WebServer::handleGetStudents(const httplib::Request &req, httplib::Response &res)
 {
     auto students = db_->getAllStudents();
@@ -217,6 +836,7 @@ json WebServer::interviewToJson(const Interview &interview)
         {"studentId", interview.studentId},
         {"companyName", interview.companyName},
         {"round", interview.round},
+        {"day", interview.timeSlot.startTime / MINUTES_PER_DAY},
         {"startTime", interview.timeSlot.startTime},
         {"endTime", interview.timeSlot.endTime},
         {"panelId", interview.panelId}